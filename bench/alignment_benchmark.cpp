@@ -0,0 +1,142 @@
+// Effect of over-aligning static_vector's element buffer with static_vector_alignment (aligned_static_vector):
+//  - axpy over arrays of static_vector<float, 256>, whose buffers land at whatever alignment the array stride gives them,
+//    against buffers aligned to 32 and 64 bytes, which the compiler can process with aligned loads and stores and no peeling,
+//  - threads each appending to their own vector of an array, with vectors sharing cache lines against vectors padded to a line.
+//
+// Build (from the repository root), for the CPU it runs on so that the loops get vectorized with its widest registers:
+//   g++ -std=c++20 -O3 -march=native -DNDEBUG -pthread -Iinc bench/alignment_benchmark.cpp -o alignment_benchmark
+//   cl /std:c++latest /O2 /arch:AVX2 /EHsc /DNDEBUG /Iinc bench\alignment_benchmark.cpp
+//
+// Usage: alignment_benchmark [filter]
+// Lines are "axpy/<alignment>" per element, and "append/<layout>/<threads>" per append.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "static_vector.hpp"
+
+namespace
+{
+	constexpr std::size_t axpy_elements = 256;
+	constexpr std::size_t axpy_vectors = 64;
+
+	template <typename Vector>
+	struct axpy_state
+	{
+		Vector xs[axpy_vectors];
+		Vector ys[axpy_vectors];
+	};
+
+	// data() carries the alignment of the buffer, which is all the compiler needs to pick aligned instructions.
+	template <typename Vector>
+	void axpy(float a, const Vector& x, Vector& y) noexcept
+	{
+		const float* const in = x.data();
+		float* const out = y.data();
+		for (std::size_t i = 0; i < y.size(); ++i)
+		{
+			out[i] = a * in[i] + out[i];
+		}
+	}
+
+	template <typename Vector>
+	void run_axpy(bench::runner& runner, const char* name)
+	{
+		runner.run(std::string("axpy/") + name, axpy_vectors * axpy_elements,
+			[]
+			{
+				auto state = std::make_unique<axpy_state<Vector>>();
+				for (std::size_t v = 0; v < axpy_vectors; ++v)
+				{
+					for (std::size_t i = 0; i < axpy_elements; ++i)
+					{
+						state->xs[v].push_back(static_cast<float>(i));
+						state->ys[v].push_back(static_cast<float>(v));
+					}
+				}
+				return state;
+			},
+			[](std::unique_ptr<axpy_state<Vector>>& state)
+			{
+				for (std::size_t v = 0; v < axpy_vectors; ++v)
+				{
+					axpy(1.5f, state->xs[v], state->ys[v]);
+				}
+				bench::do_not_optimize(state->ys[0][0]);
+			});
+	}
+
+	constexpr std::size_t appends_per_thread = std::size_t{ 1 } << 20;
+
+	// Six elements and a size: 56 bytes unpadded, so neighbouring threads write to the same cache lines.
+	using shared_lines = static_vector<std::uint64_t, 6>;
+	using padded_lines = aligned_static_vector<std::uint64_t, 6, alignof(std::uint64_t), true>;
+
+	template <typename Vector>
+	void append(Vector& vector) noexcept
+	{
+		for (std::size_t i = 0; i < appends_per_thread; ++i)
+		{
+			if (vector.free_space() == 0)
+			{
+				vector.clear();
+			}
+			vector.push_back(i);
+			bench::do_not_optimize(vector);
+		}
+	}
+
+	template <typename Vector>
+	void run_append(bench::runner& runner, const char* name, unsigned threads)
+	{
+		runner.run(std::string("append/") + name + "/" + std::to_string(threads), threads * appends_per_thread,
+			[=] { return std::make_unique<Vector[]>(threads); },
+			[=](std::unique_ptr<Vector[]>& vectors)
+			{
+				std::vector<std::thread> workers;
+				for (unsigned t = 0; t < threads; ++t)
+				{
+					workers.emplace_back([&vectors, t] { append(vectors[t]); });
+				}
+				for (std::thread& worker : workers)
+				{
+					worker.join();
+				}
+			});
+	}
+}
+
+int main(int argc, char** argv)
+{
+	bench::runner runner(argc > 1 ? argv[1] : "");
+
+	if (!runner.counters_available())
+	{
+		std::printf("perf_event_open unavailable, reporting time only\n");
+	}
+
+	std::printf("sizeof: static_vector<float, 256> %zu, aligned to 32 %zu, to 64 %zu; append vectors %zu shared, %zu padded\n",
+		sizeof(static_vector<float, axpy_elements>), sizeof(aligned_static_vector<float, axpy_elements, 32>),
+		sizeof(aligned_static_vector<float, axpy_elements, 64>), sizeof(shared_lines), sizeof(padded_lines));
+
+	runner.print_header();
+
+	run_axpy<static_vector<float, axpy_elements>>(runner, "alignof(float)");
+	run_axpy<aligned_static_vector<float, axpy_elements, 32>>(runner, "32");
+	run_axpy<aligned_static_vector<float, axpy_elements, 64>>(runner, "64");
+
+	const unsigned cores = std::max(2u, std::min(8u, std::thread::hardware_concurrency()));
+	if (std::thread::hardware_concurrency() < 2)
+	{
+		std::printf("fewer than two cores, the append threads take turns and can't contend for cache lines\n");
+	}
+
+	run_append<shared_lines>(runner, "shared lines", cores);
+	run_append<padded_lines>(runner, "padded", cores);
+}
@@ -0,0 +1,234 @@
+#pragma once
+
+// Minimal timing harness shared by the benchmarks in this directory.
+// Times a body with std::chrono::steady_clock and, on Linux, reads cycles, instructions and cache misses through perf_event_open.
+// When the counters aren't available (non Linux, restrictive perf_event_paranoid, containers...), only the time is reported.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace bench
+{
+	struct counters
+	{
+		double cycles = 0;
+		double instructions = 0;
+		double cache_misses = 0;
+	};
+
+#if defined(__linux__)
+	class perf_counters
+	{
+	public:
+		perf_counters() noexcept
+		{
+			_leader = open_counter(PERF_COUNT_HW_CPU_CYCLES, -1);
+			if (_leader < 0)
+			{
+				return;
+			}
+
+			_instructions = open_counter(PERF_COUNT_HW_INSTRUCTIONS, _leader);
+			_cache_misses = open_counter(PERF_COUNT_HW_CACHE_MISSES, _leader);
+
+			if (_instructions < 0 || _cache_misses < 0)
+			{
+				close_all();
+			}
+		}
+
+		perf_counters(const perf_counters&) = delete;
+		perf_counters& operator=(const perf_counters&) = delete;
+
+		~perf_counters()
+		{
+			close_all();
+		}
+
+		bool available() const noexcept
+		{
+			return _leader >= 0;
+		}
+
+		void start() noexcept
+		{
+			if (available())
+			{
+				ioctl(_leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+				ioctl(_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+			}
+		}
+
+		counters stop() noexcept
+		{
+			counters result;
+
+			if (!available())
+			{
+				return result;
+			}
+
+			ioctl(_leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+			// PERF_FORMAT_GROUP layout: number of events followed by one value per event, in the order they were opened.
+			std::uint64_t values[4]{};
+			if (read(_leader, values, sizeof(values)) >= static_cast<ssize_t>(sizeof(std::uint64_t) * 4))
+			{
+				result.cycles = static_cast<double>(values[1]);
+				result.instructions = static_cast<double>(values[2]);
+				result.cache_misses = static_cast<double>(values[3]);
+			}
+
+			return result;
+		}
+
+	private:
+		static int open_counter(std::uint64_t config, int group) noexcept
+		{
+			perf_event_attr attr;
+			std::memset(&attr, 0, sizeof(attr));
+			attr.type = PERF_TYPE_HARDWARE;
+			attr.size = sizeof(attr);
+			attr.config = config;
+			attr.disabled = group == -1;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			attr.read_format = PERF_FORMAT_GROUP;
+
+			return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group, 0));
+		}
+
+		void close_all() noexcept
+		{
+			for (int* fd : { &_cache_misses, &_instructions, &_leader })
+			{
+				if (*fd >= 0)
+				{
+					close(*fd);
+					*fd = -1;
+				}
+			}
+		}
+
+		int _leader = -1;
+		int _instructions = -1;
+		int _cache_misses = -1;
+	};
+#else
+	class perf_counters
+	{
+	public:
+		bool available() const noexcept
+		{
+			return false;
+		}
+
+		void start() noexcept {}
+
+		counters stop() noexcept
+		{
+			return {};
+		}
+	};
+#endif
+
+	// Keeps the optimizer from discarding a value or the stores leading to it.
+	template <typename T>
+	inline void do_not_optimize(T&& value) noexcept
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		static volatile char sink;
+		sink = *reinterpret_cast<const volatile char*>(std::addressof(value));
+#endif
+	}
+
+	class runner
+	{
+	public:
+		explicit runner(std::string_view filter = {}) noexcept
+			: _filter(filter)
+		{
+		}
+
+		bool counters_available() const noexcept
+		{
+			return _counters.available();
+		}
+
+		void print_header() const
+		{
+			std::printf("%-56s %12s %12s %12s %12s\n", "benchmark", "ns/op", "cycles/op", "instr/op", "misses/op");
+		}
+
+		// Runs setup() + body(state) repeatedly until at least min_ops operations were timed, reporting the fastest repetition.
+		// Only body is measured; setup and the destruction of the state happen outside the timed region.
+		template <typename Setup, typename Body>
+		void run(const std::string& name, std::size_t ops_per_run, Setup&& setup, Body&& body)
+		{
+			if (!_filter.empty() && name.find(_filter) == std::string::npos)
+			{
+				return;
+			}
+
+			constexpr std::size_t min_ops = std::size_t{ 1 } << 20;
+			const std::size_t repetitions = std::clamp<std::size_t>(min_ops / std::max<std::size_t>(ops_per_run, 1), 5, 2000);
+
+			double best_ns = std::numeric_limits<double>::max();
+			counters best_counters;
+
+			for (std::size_t i = 0; i < repetitions; ++i)
+			{
+				auto state = setup();
+
+				_counters.start();
+				const auto start = std::chrono::steady_clock::now();
+				body(state);
+				const auto stop = std::chrono::steady_clock::now();
+				const counters measured = _counters.stop();
+
+				do_not_optimize(state);
+
+				const double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+				if (ns < best_ns)
+				{
+					best_ns = ns;
+					best_counters = measured;
+				}
+			}
+
+			const double ops = static_cast<double>(ops_per_run);
+
+			if (_counters.available())
+			{
+				std::printf("%-56s %12.2f %12.2f %12.2f %12.4f\n", name.c_str(), best_ns / ops,
+					best_counters.cycles / ops, best_counters.instructions / ops, best_counters.cache_misses / ops);
+			}
+			else
+			{
+				std::printf("%-56s %12.2f %12s %12s %12s\n", name.c_str(), best_ns / ops, "n/a", "n/a", "n/a");
+			}
+			std::fflush(stdout);
+		}
+
+	private:
+		std::string_view _filter;
+		perf_counters _counters;
+	};
+}
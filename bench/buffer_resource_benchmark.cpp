@@ -0,0 +1,104 @@
+// A request handler's worth of short lived std::pmr containers, allocated from the global heap, from a static_buffer_resource
+// on the stack, and from one with size classes.
+//
+// Build (from the repository root):
+//   g++ -std=c++20 -O2 -DNDEBUG -Iinc bench/buffer_resource_benchmark.cpp -o buffer_resource_benchmark
+//   cl /std:c++latest /O2 /EHsc /DNDEBUG /Iinc bench\buffer_resource_benchmark.cpp
+//
+// Usage: buffer_resource_benchmark [filter]
+
+#include <cstdio>
+#include <memory_resource>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "static_buffer_resource.hpp"
+
+namespace
+{
+	constexpr std::size_t requests = 1024;
+
+	// Parses a few headers into a map and builds a response out of strings, roughly what a small handler allocates.
+	std::size_t handle_request(std::pmr::memory_resource* resource, std::size_t request)
+	{
+		std::pmr::unordered_map<std::pmr::string, std::pmr::string> headers(resource);
+		for (std::size_t i = 0; i < 16; ++i)
+		{
+			headers.emplace(std::pmr::string("x-header-name-number-" + std::to_string(i), resource),
+				std::pmr::string("a header value long enough to skip the small string buffer " + std::to_string(request), resource));
+		}
+
+		std::pmr::vector<std::pmr::string> lines(resource);
+		for (const auto& [name, value] : headers)
+		{
+			std::pmr::string line(resource);
+			line += name;
+			line += ": ";
+			line += value;
+			lines.push_back(std::move(line));
+		}
+
+		std::size_t bytes = 0;
+		for (const auto& line : lines)
+		{
+			bytes += line.size();
+		}
+		return bytes;
+	}
+
+	void run_heap(bench::runner& runner)
+	{
+		runner.run("new_delete_resource/request", requests,
+			[] { return 0; },
+			[](int&)
+			{
+				std::size_t bytes = 0;
+				for (std::size_t request = 0; request < requests; ++request)
+				{
+					bytes += handle_request(std::pmr::new_delete_resource(), request);
+				}
+				bench::do_not_optimize(bytes);
+			});
+	}
+
+	template <bool Size_Classes>
+	void run_static(bench::runner& runner, const char* name)
+	{
+		runner.run(name, requests,
+			[] { return 0; },
+			[](int&)
+			{
+				std::size_t bytes = 0;
+				for (std::size_t request = 0; request < requests; ++request)
+				{
+					static_buffer_resource<16384, Size_Classes> arena(std::pmr::new_delete_resource());
+					bytes += handle_request(&arena, request);
+				}
+				bench::do_not_optimize(bytes);
+			});
+	}
+}
+
+int main(int argc, char** argv)
+{
+	bench::runner runner(argc > 1 ? argv[1] : "");
+
+	if (!runner.counters_available())
+	{
+		std::printf("perf_event_open unavailable, reporting time only\n");
+	}
+
+	{
+		static_buffer_resource<16384> probe;
+		handle_request(&probe, 0);
+		std::printf("one request needs %zu bytes of buffer\n", probe.peak_bytes());
+	}
+
+	runner.print_header();
+
+	run_heap(runner);
+	run_static<false>(runner, "static_buffer_resource<16384>/request");
+	run_static<true>(runner, "static_buffer_resource<16384, size classes>/request");
+}
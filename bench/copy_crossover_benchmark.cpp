@@ -0,0 +1,91 @@
+// Finds where copying only the live elements of a trivially copyable static_vector starts to beat the defaulted whole-buffer copy,
+// which is what STATIC_VECTOR_LIVE_PREFIX_COPY_BYTES is tuned from.
+//
+// Build (from the repository root):
+//   g++ -std=c++20 -O2 -DNDEBUG -Iinc bench/copy_crossover_benchmark.cpp -o copy_crossover_benchmark
+//   cl /std:c++latest /O2 /EHsc /DNDEBUG /Iinc bench\copy_crossover_benchmark.cpp
+//
+// Usage: copy_crossover_benchmark [filter]
+// Each line is "<mode>/<buffer bytes>/<fill>", e.g. filter with "/4096/" or "live_prefix".
+
+#include <cstdio>
+#include <memory>
+#include <new>
+#include <string>
+
+#include "benchmark.hpp"
+#include "static_vector.hpp"
+
+namespace
+{
+	template <typename Vector>
+	struct raw_slot
+	{
+		alignas(Vector) std::byte bytes[sizeof(Vector)];
+	};
+
+	template <bool Live_Prefix, std::size_t Capacity>
+	void run_copy(bench::runner& runner, const char* fill_name, std::size_t fill)
+	{
+		using vector = static_vector<int, Capacity, static_vector_copy_mode<Live_Prefix>>;
+
+		const std::string name = std::string(Live_Prefix ? "live_prefix" : "whole_buffer") + "/" + std::to_string(Capacity * sizeof(int)) + "/" + fill_name;
+		const std::size_t batch = std::max<std::size_t>(1, 65536 / Capacity);
+
+		runner.run(name, batch,
+			[&]
+			{
+				auto source = std::make_unique<vector>();
+				for (std::size_t i = 0; i < fill; ++i)
+				{
+					source->push_back(static_cast<int>(i));
+				}
+				return std::make_pair(std::move(source), std::make_unique<raw_slot<vector>>());
+			},
+			[&](auto& state)
+			{
+				auto& [source, slot] = state;
+				for (std::size_t i = 0; i < batch; ++i)
+				{
+					// Copying a fresh object each time, the copy can't be elided or hoisted.
+					bench::do_not_optimize(source);
+					vector* copy = ::new (static_cast<void*>(slot->bytes)) vector(*source);
+					bench::do_not_optimize(copy);
+				}
+			});
+	}
+
+	template <std::size_t Capacity>
+	void run_capacity(bench::runner& runner)
+	{
+		run_copy<false, Capacity>(runner, "1", 1);
+		run_copy<true, Capacity>(runner, "1", 1);
+		run_copy<false, Capacity>(runner, "25%", Capacity / 4);
+		run_copy<true, Capacity>(runner, "25%", Capacity / 4);
+		run_copy<false, Capacity>(runner, "100%", Capacity);
+		run_copy<true, Capacity>(runner, "100%", Capacity);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	bench::runner runner(argc > 1 ? argv[1] : "");
+
+	if (!runner.counters_available())
+	{
+		std::printf("perf_event_open unavailable, reporting time only\n");
+	}
+
+	runner.print_header();
+
+	run_capacity<16>(runner);
+	run_capacity<32>(runner);
+	run_capacity<64>(runner);
+	run_capacity<128>(runner);
+	run_capacity<256>(runner);
+	run_capacity<512>(runner);
+	run_capacity<1024>(runner);
+	run_capacity<4096>(runner);
+	run_capacity<16384>(runner);
+	run_capacity<65536>(runner);
+}
@@ -0,0 +1,123 @@
+// Random lookups in sorted tables: static_vector<std::pair<K, V>> searched with std::lower_bound, which is what static_flat_map
+// replaces, against static_flat_map with the sorted and the Eytzinger layout. Half of the looked up keys are present.
+//
+// Build (from the repository root):
+//   g++ -std=c++20 -O2 -DNDEBUG -Iinc bench/flat_map_benchmark.cpp -o flat_map_benchmark
+//   cl /std:c++latest /O2 /EHsc /DNDEBUG /Iinc bench\flat_map_benchmark.cpp
+//
+// Usage: flat_map_benchmark [filter]
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "static_flat_map.hpp"
+
+namespace
+{
+	constexpr std::size_t lookups = 4096;
+
+	// Even keys are in the tables, so odd probes miss.
+	template <std::size_t Size>
+	std::vector<std::uint32_t> make_probes()
+	{
+		std::mt19937 generator(Size);
+		std::uniform_int_distribution<std::uint32_t> distribution(0, 2 * Size - 1);
+
+		std::vector<std::uint32_t> probes(lookups);
+		for (std::uint32_t& probe : probes)
+		{
+			probe = distribution(generator);
+		}
+		return probes;
+	}
+
+	template <std::size_t Size>
+	void run_pair_vector(bench::runner& runner)
+	{
+		using table_type = static_vector<std::pair<std::uint32_t, std::uint32_t>, Size>;
+
+		auto table = std::make_unique<table_type>();
+		for (std::uint32_t i = 0; i < Size; ++i)
+		{
+			table->push_back({ 2 * i, i });
+		}
+		const std::vector<std::uint32_t> probes = make_probes<Size>();
+
+		runner.run("pair static_vector+std::lower_bound/" + std::to_string(Size), lookups,
+			[] { return 0; },
+			[&](int&)
+			{
+				std::uint32_t sum = 0;
+				for (const std::uint32_t probe : probes)
+				{
+					const auto it = std::lower_bound(table->begin(), table->end(), probe, [](const auto& pair, std::uint32_t key) { return pair.first < key; });
+					if (it != table->end() && it->first == probe)
+					{
+						sum += it->second;
+					}
+				}
+				bench::do_not_optimize(sum);
+			});
+	}
+
+	template <std::size_t Size, flat_layout Layout>
+	void run_flat_map(bench::runner& runner, const char* layout_name)
+	{
+		using table_type = static_flat_map<std::uint32_t, std::uint32_t, Size, std::less<std::uint32_t>, Layout>;
+
+		std::vector<std::pair<std::uint32_t, std::uint32_t>> pairs;
+		for (std::uint32_t i = 0; i < Size; ++i)
+		{
+			pairs.emplace_back(2 * i, i);
+		}
+
+		auto table = std::make_unique<table_type>(sorted_range, pairs);
+		const std::vector<std::uint32_t> probes = make_probes<Size>();
+
+		runner.run(std::string("static_flat_map ") + layout_name + "/" + std::to_string(Size), lookups,
+			[] { return 0; },
+			[&](int&)
+			{
+				std::uint32_t sum = 0;
+				for (const std::uint32_t probe : probes)
+				{
+					if (const std::uint32_t* value = table->find_value(probe))
+					{
+						sum += *value;
+					}
+				}
+				bench::do_not_optimize(sum);
+			});
+	}
+
+	template <std::size_t Size>
+	void run_size(bench::runner& runner)
+	{
+		run_pair_vector<Size>(runner);
+		run_flat_map<Size, flat_layout::sorted>(runner, "sorted");
+		run_flat_map<Size, flat_layout::eytzinger>(runner, "eytzinger");
+	}
+}
+
+int main(int argc, char** argv)
+{
+	bench::runner runner(argc > 1 ? argv[1] : "");
+
+	if (!runner.counters_available())
+	{
+		std::printf("perf_event_open unavailable, reporting time only\n");
+	}
+
+	runner.print_header();
+
+	run_size<64>(runner);
+	run_size<1024>(runner);
+	run_size<16384>(runner);
+	run_size<262144>(runner);
+}
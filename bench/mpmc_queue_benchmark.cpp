@@ -0,0 +1,228 @@
+// Throughput of static_mpmc_queue with 1..N producers and as many consumers, against a mutex protected std::deque.
+// Every thread is pinned to a core of its own where the platform allows it and there are enough of them.
+//
+// Build (from the repository root):
+//   g++ -std=c++20 -O2 -DNDEBUG -pthread -Iinc bench/mpmc_queue_benchmark.cpp -o mpmc_queue_benchmark
+//   cl /std:c++latest /O2 /EHsc /DNDEBUG /Iinc bench\mpmc_queue_benchmark.cpp
+//
+// Usage: mpmc_queue_benchmark [filter]
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+
+#include "benchmark.hpp"
+#include "static_mpmc_queue.hpp"
+
+namespace
+{
+	void pin_current_thread(unsigned core) noexcept
+	{
+		if (std::thread::hardware_concurrency() <= core)
+		{
+			return;
+		}
+
+#if defined(__linux__)
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		CPU_SET(core, &set);
+		pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#elif defined(_WIN32)
+		SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR{ 1 } << core);
+#endif
+	}
+
+	// With more threads than cores, a spinning thread keeps the one it waits for off the core.
+	void wait_a_bit(unsigned threads) noexcept
+	{
+		if (std::thread::hardware_concurrency() < threads)
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	// The baseline the queue is meant to replace.
+	template <typename T>
+	class locked_deque
+	{
+	public:
+		bool try_push(const T& value)
+		{
+			std::lock_guard lock(_mutex);
+			_items.push_back(value);
+			return true;
+		}
+
+		bool try_pop(T& value)
+		{
+			std::lock_guard lock(_mutex);
+			if (_items.empty())
+			{
+				return false;
+			}
+			value = _items.front();
+			_items.pop_front();
+			return true;
+		}
+
+	private:
+		std::mutex _mutex;
+		std::deque<T> _items;
+	};
+
+	constexpr std::size_t messages = std::size_t{ 1 } << 20;
+
+	// producers threads push messages / producers values each with try_push, as many consumers pop until all messages are through.
+	// The calling thread only starts and joins the others.
+	template <typename Queue>
+	void run_throughput(bench::runner& runner, const std::string& name, unsigned producers)
+	{
+		runner.run(name + "/" + std::to_string(producers) + "x" + std::to_string(producers) + "/throughput", messages,
+			[] { return std::make_unique<Queue>(); },
+			[producers](auto& queue)
+			{
+				const unsigned threads = 2 * producers;
+				const std::size_t per_producer = messages / producers;
+				std::atomic<std::size_t> remaining = per_producer * producers;
+
+				std::vector<std::thread> workers;
+				workers.reserve(threads);
+
+				for (unsigned p = 0; p < producers; ++p)
+				{
+					workers.emplace_back([&, p]
+					{
+						pin_current_thread(p);
+						for (std::uint64_t i = 0; i < per_producer;)
+						{
+							if (queue->try_push(i))
+							{
+								++i;
+							}
+							else
+							{
+								wait_a_bit(threads);
+							}
+						}
+					});
+				}
+
+				for (unsigned c = 0; c < producers; ++c)
+				{
+					workers.emplace_back([&, c]
+					{
+						pin_current_thread(producers + c);
+						std::uint64_t value = 0;
+						std::uint64_t sum = 0;
+						while (remaining.load(std::memory_order_relaxed) != 0)
+						{
+							if (queue->try_pop(value))
+							{
+								sum += value;
+								remaining.fetch_sub(1, std::memory_order_relaxed);
+							}
+							else
+							{
+								wait_a_bit(threads);
+							}
+						}
+						bench::do_not_optimize(sum);
+					});
+				}
+
+				for (std::thread& worker : workers)
+				{
+					worker.join();
+				}
+			});
+	}
+
+	// The same with the blocking push and pop, every consumer takes an equal share.
+	template <std::size_t Capacity>
+	void run_blocking_throughput(bench::runner& runner, unsigned producers)
+	{
+		using queue_type = static_mpmc_queue<std::uint64_t, Capacity>;
+
+		runner.run("static_mpmc_queue<" + std::to_string(Capacity) + ">/" + std::to_string(producers) + "x" + std::to_string(producers) + "/blocking", messages,
+			[] { return std::make_unique<queue_type>(); },
+			[producers](auto& queue)
+			{
+				const std::size_t per_thread = messages / producers;
+
+				std::vector<std::thread> workers;
+				workers.reserve(2 * producers);
+
+				for (unsigned p = 0; p < producers; ++p)
+				{
+					workers.emplace_back([&, p]
+					{
+						pin_current_thread(p);
+						for (std::uint64_t i = 0; i < per_thread; ++i)
+						{
+							queue->push(i);
+						}
+					});
+				}
+
+				for (unsigned c = 0; c < producers; ++c)
+				{
+					workers.emplace_back([&, c]
+					{
+						pin_current_thread(producers + c);
+						std::uint64_t sum = 0;
+						for (std::size_t i = 0; i < per_thread; ++i)
+						{
+							sum += queue->pop();
+						}
+						bench::do_not_optimize(sum);
+					});
+				}
+
+				for (std::thread& worker : workers)
+				{
+					worker.join();
+				}
+			});
+	}
+}
+
+int main(int argc, char** argv)
+{
+	bench::runner runner(argc > 1 ? argv[1] : "");
+
+	if (!runner.counters_available())
+	{
+		std::printf("perf_event_open unavailable, reporting time only\n");
+	}
+
+	const unsigned cores = std::thread::hardware_concurrency();
+	if (cores < 2)
+	{
+		std::printf("fewer than two cores, threads yield instead of spinning and results are not representative\n");
+	}
+
+	runner.print_header();
+
+	// Up to one thread per core, but always at least one producer and one consumer.
+	for (unsigned producers = 1; producers == 1 || 2 * producers <= cores; producers *= 2)
+	{
+		run_throughput<static_mpmc_queue<std::uint64_t, 1024>>(runner, "static_mpmc_queue<1024>", producers);
+		run_throughput<static_mpmc_queue<std::uint64_t, 65536>>(runner, "static_mpmc_queue<65536>", producers);
+		run_throughput<locked_deque<std::uint64_t>>(runner, "mutex+std::deque", producers);
+		run_blocking_throughput<1024>(runner, producers);
+	}
+}
@@ -0,0 +1,189 @@
+// The execution policy overloads of static_vector's bulk operations against their sequential counterparts, on a
+// static_vector<sample, 1 << 20> (16 MiB) filled to 4 Ki, 64 Ki and 1 Mi elements. STATIC_VECTOR_PARALLEL_MIN_BYTES is lowered
+// to 0 here, so that the parallel lines always run in parallel and show where that starts to pay off.
+//
+// Build (from the repository root). libstdc++ runs std::execution::par on TBB:
+//   g++ -std=c++20 -O2 -DNDEBUG -Iinc bench/parallel_bulk_benchmark.cpp -o parallel_bulk_benchmark -ltbb
+//   cl /std:c++latest /O2 /EHsc /DNDEBUG /Iinc bench\parallel_bulk_benchmark.cpp
+//
+// Usage: parallel_bulk_benchmark [filter]
+// Lines are "<operation>/<seq|par>/<elements>", per element.
+
+#define STATIC_VECTOR_HAS_EXECUTION 1
+#define STATIC_VECTOR_PARALLEL_MIN_BYTES 0
+
+#include <cstdint>
+#include <cstdio>
+#include <execution>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+
+#include "benchmark.hpp"
+#include "static_vector.hpp"
+
+namespace
+{
+	struct sample
+	{
+		std::uint64_t timestamp;
+		float value;
+		std::uint32_t channel;
+	};
+
+	constexpr std::size_t capacity = std::size_t{ 1 } << 20;
+	using table = static_vector<sample, capacity>;
+
+	// Large enough that its elements are destroyed one by one.
+	using names = static_vector<std::string, capacity>;
+
+	// Storage to construct the vectors into, so that only the constructor is timed and not the allocation.
+	template <typename Vector>
+	struct raw_slot
+	{
+		alignas(Vector) std::byte bytes[sizeof(Vector)];
+
+		~raw_slot()
+		{
+			std::launder(reinterpret_cast<Vector*>(bytes))->~Vector();
+		}
+	};
+
+	std::unique_ptr<table> filled(std::size_t count)
+	{
+		auto vector = std::make_unique<table>();
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			vector->unchecked_emplace_back(sample{ i, static_cast<float>(i), static_cast<std::uint32_t>(i % 64) });
+		}
+		return vector;
+	}
+
+	std::string label(const char* operation, bool parallel, std::size_t count)
+	{
+		return std::string(operation) + (parallel ? "/par/" : "/seq/") + std::to_string(count);
+	}
+
+	template <bool Parallel>
+	void run_construct(bench::runner& runner, std::size_t count)
+	{
+		runner.run(label("construct value", Parallel, count), count,
+			[] { return std::make_unique<raw_slot<table>>(); },
+			[=](std::unique_ptr<raw_slot<table>>& slot)
+			{
+				if constexpr (Parallel)
+				{
+					::new (static_cast<void*>(slot->bytes)) table(std::execution::par, count, sample{ 1, 1.0f, 1 });
+				}
+				else
+				{
+					::new (static_cast<void*>(slot->bytes)) table(count, sample{ 1, 1.0f, 1 });
+				}
+			});
+	}
+
+	template <bool Parallel>
+	void run_copy(bench::runner& runner, std::size_t count)
+	{
+		const std::shared_ptr<const table> source = filled(count);
+
+		runner.run(label("copy", Parallel, count), count,
+			[] { return std::make_unique<raw_slot<table>>(); },
+			[&](std::unique_ptr<raw_slot<table>>& slot)
+			{
+				if constexpr (Parallel)
+				{
+					::new (static_cast<void*>(slot->bytes)) table(std::execution::par, *source);
+				}
+				else
+				{
+					::new (static_cast<void*>(slot->bytes)) table(*source);
+				}
+			});
+	}
+
+	template <bool Parallel>
+	void run_assign(bench::runner& runner, std::size_t count)
+	{
+		runner.run(label("assign", Parallel, count), count,
+			[] { return std::make_unique<table>(); },
+			[=](std::unique_ptr<table>& vector)
+			{
+				if constexpr (Parallel)
+				{
+					vector->assign(std::execution::par, count, sample{ 2, 2.0f, 2 });
+				}
+				else
+				{
+					vector->assign(count, sample{ 2, 2.0f, 2 });
+				}
+			});
+	}
+
+	template <bool Parallel>
+	void run_transform(bench::runner& runner, std::size_t count)
+	{
+		const std::shared_ptr<const table> source = filled(count);
+		const auto calibrate = [](const sample& raw) { return sample{ raw.timestamp, raw.value * 0.5f + 3.0f, raw.channel }; };
+
+		runner.run(label("assign_transformed", Parallel, count), count,
+			[] { return std::make_unique<table>(); },
+			[&](std::unique_ptr<table>& vector)
+			{
+				if constexpr (Parallel)
+				{
+					vector->assign_transformed(std::execution::par, source->begin(), source->end(), calibrate);
+				}
+				else
+				{
+					vector->assign_transformed(std::execution::seq, source->begin(), source->end(), calibrate);
+				}
+			});
+	}
+
+	template <bool Parallel>
+	void run_clear(bench::runner& runner, std::size_t count)
+	{
+		runner.run(label("clear strings", Parallel, count), count,
+			[=] { return std::make_unique<names>(count, std::string(40, 'n')); },
+			[](std::unique_ptr<names>& vector)
+			{
+				if constexpr (Parallel)
+				{
+					vector->clear(std::execution::par);
+				}
+				else
+				{
+					vector->clear();
+				}
+			});
+	}
+}
+
+int main(int argc, char** argv)
+{
+	bench::runner runner(argc > 1 ? argv[1] : "");
+
+	if (!runner.counters_available())
+	{
+		std::printf("perf_event_open unavailable, reporting time only\n");
+	}
+	std::printf("%u hardware threads\n", std::thread::hardware_concurrency());
+
+	runner.print_header();
+
+	for (const std::size_t count : { std::size_t{ 1 } << 12, std::size_t{ 1 } << 16, capacity })
+	{
+		run_construct<false>(runner, count);
+		run_construct<true>(runner, count);
+		run_copy<false>(runner, count);
+		run_copy<true>(runner, count);
+		run_assign<false>(runner, count);
+		run_assign<true>(runner, count);
+		run_transform<false>(runner, count);
+		run_transform<true>(runner, count);
+		run_clear<false>(runner, count);
+		run_clear<true>(runner, count);
+	}
+}
@@ -0,0 +1,237 @@
+// A lookup table shared by worker processes, created once in a memfd. First forks the workers (32 by default), which attach to the
+// table and read it while it is being filled, and exits with 1 if any of them saw an incompletely written entry. Then times the
+// startup of a worker attaching to the finished table in place, against building a private copy of it.
+//
+// Build (from the repository root, Linux only):
+//   g++ -std=c++20 -O2 -DNDEBUG -Iinc bench/shared_table_benchmark.cpp -o shared_table_benchmark
+//
+// Usage: shared_table_benchmark [filter] [workers]
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+#include "benchmark.hpp"
+#include "static_vector.hpp"
+
+#if defined(__linux__)
+
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace
+{
+	struct entry
+	{
+		std::uint64_t key;
+		std::uint64_t value;
+		std::uint64_t check;
+	};
+
+	constexpr std::size_t table_size = std::size_t{ 1 } << 16;
+	using table = static_vector<entry, table_size>;
+
+	entry make_entry(std::uint64_t key) noexcept
+	{
+		const std::uint64_t value = key * 0x9E3779B97F4A7C15ull;
+		return entry{ key, value, key ^ value ^ 0xA5A5A5A5A5A5A5A5ull };
+	}
+
+	bool is_complete(const entry& e, std::uint64_t key) noexcept
+	{
+		const entry expected = make_entry(key);
+		return e.key == expected.key && e.value == expected.value && e.check == expected.check;
+	}
+
+	// A shared mapping of a fresh memfd big enough for the table, as a parent would hand it to the workers it forks.
+	int create_region()
+	{
+		const int fd = memfd_create("static_vector_table", 0);
+		if (fd < 0 || ftruncate(fd, static_cast<off_t>(table::region_bytes())) != 0)
+		{
+			std::perror("memfd_create");
+			std::exit(1);
+		}
+		return fd;
+	}
+
+	void* map_region(int fd)
+	{
+		void* const memory = mmap(nullptr, table::region_bytes(), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		if (memory == MAP_FAILED)
+		{
+			std::perror("mmap");
+			std::exit(1);
+		}
+		return memory;
+	}
+
+	// Each worker maps the region on its own, like an unrelated process opening it by name would.
+	table* attach_region(int fd)
+	{
+		static_vector_wire_status status;
+		table* const shared = table::attach(map_region(fd), table::region_bytes(), &status);
+		if (shared == nullptr)
+		{
+			std::fprintf(stderr, "attach failed with status %d\n", static_cast<int>(status));
+			std::_Exit(1);
+		}
+		return shared;
+	}
+
+	// Returns an exit status for the worker: 0 if everything it saw of the table was completely written.
+	int read_while_filling(int fd)
+	{
+		const table* const shared = attach_region(fd);
+
+		std::size_t checked = 0;
+		while (checked < table_size)
+		{
+			const std::span<const entry> entries = shared->published();
+			if (entries.size() < checked)
+			{
+				return 1;
+			}
+			for (; checked < entries.size(); ++checked)
+			{
+				if (!is_complete(entries[checked], checked))
+				{
+					return 1;
+				}
+			}
+			sched_yield();
+		}
+		return 0;
+	}
+
+	bool check_consistency(std::size_t workers)
+	{
+		const int fd = create_region();
+		table* const shared = table::create_at(map_region(fd), table::region_bytes());
+
+		for (std::size_t worker = 0; worker < workers; ++worker)
+		{
+			if (fork() == 0)
+			{
+				std::_Exit(read_while_filling(fd));
+			}
+		}
+
+		// Alternates single appends and batches, yielding now and then so the workers read a table that is still growing.
+		entry batch[64];
+		std::uint64_t key = 0;
+		while (key < table_size)
+		{
+			if ((key / 64) % 2 == 0)
+			{
+				shared->publish_emplace_back(make_entry(key++));
+			}
+			else
+			{
+				const std::size_t count = std::min<std::size_t>(std::size(batch), table_size - key);
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					batch[i] = make_entry(key + i);
+				}
+				shared->publish_append(std::span<const entry>(batch, count));
+				key += count;
+			}
+			if (key % 1024 == 0)
+			{
+				sched_yield();
+			}
+		}
+
+		bool consistent = true;
+		for (std::size_t worker = 0; worker < workers; ++worker)
+		{
+			int status = 0;
+			wait(&status);
+			consistent = consistent && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+		}
+
+		close(fd);
+		return consistent;
+	}
+
+	std::uint64_t probe(const entry* entries) noexcept
+	{
+		std::uint64_t sum = 0;
+		for (std::size_t key = 0; key < table_size; key += 61)
+		{
+			sum += entries[key].value;
+		}
+		return sum;
+	}
+
+	// What a worker does at startup before serving lookups, timed in one process: mapping and attaching to the shared table,
+	// or building a private copy of it.
+	void run_attach(bench::runner& runner, int fd)
+	{
+		runner.run("attach/worker startup", 1,
+			[] { return 0; },
+			[&](int&)
+			{
+				void* const memory = map_region(fd);
+				const table* const shared = table::attach(memory, table::region_bytes());
+				bench::do_not_optimize(probe(shared->data()));
+				munmap(memory, table::region_bytes());
+			});
+	}
+
+	void run_private_copy(bench::runner& runner)
+	{
+		runner.run("private copy/worker startup", 1,
+			[] { return std::make_unique<table>(); },
+			[](std::unique_ptr<table>& local)
+			{
+				for (std::uint64_t key = 0; key < table_size; ++key)
+				{
+					local->unchecked_emplace_back(make_entry(key));
+				}
+				bench::do_not_optimize(probe(local->data()));
+			});
+	}
+}
+
+int main(int argc, char** argv)
+{
+	bench::runner runner(argc > 1 ? argv[1] : "");
+	const std::size_t workers = argc > 2 ? static_cast<std::size_t>(std::atoi(argv[2])) : 32;
+
+	if (!check_consistency(workers))
+	{
+		std::printf("a worker saw an incompletely written entry\n");
+		return 1;
+	}
+	std::printf("%zu workers only saw completely written entries\n", workers);
+
+	if (!runner.counters_available())
+	{
+		std::printf("perf_event_open unavailable, reporting time only\n");
+	}
+
+	runner.print_header();
+
+	const int fd = create_region();
+	table* const shared = table::create_at(map_region(fd), table::region_bytes());
+	for (std::uint64_t key = 0; key < table_size; ++key)
+	{
+		shared->publish_emplace_back(make_entry(key));
+	}
+
+	run_attach(runner, fd);
+	run_private_copy(runner);
+}
+
+#else
+
+int main()
+{
+	std::printf("shared_table_benchmark needs Linux (memfd_create and fork)\n");
+}
+
+#endif
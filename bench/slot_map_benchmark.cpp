@@ -0,0 +1,116 @@
+// A frame's worth of pool traffic on static_slot_map against std::unordered_map<id, T>: looking every live object up by its key,
+// then retiring a quarter of them and spawning as many new ones.
+//
+// Build (from the repository root):
+//   g++ -std=c++20 -O2 -DNDEBUG -Iinc bench/slot_map_benchmark.cpp -o slot_map_benchmark
+//   cl /std:c++latest /O2 /EHsc /DNDEBUG /Iinc bench\slot_map_benchmark.cpp
+//
+// Usage: slot_map_benchmark [filter]
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "static_slot_map.hpp"
+
+namespace
+{
+	struct entity
+	{
+		float position[3];
+		float velocity[3];
+		std::uint32_t flags;
+	};
+
+	template <std::size_t Size>
+	void run_slot_map(bench::runner& runner)
+	{
+		using map_type = static_slot_map<entity, Size>;
+
+		runner.run("static_slot_map/frame/" + std::to_string(Size), Size,
+			[]
+			{
+				auto state = std::make_pair(std::make_unique<map_type>(), std::vector<typename map_type::handle>());
+				for (std::size_t i = 0; i < Size; ++i)
+				{
+					state.second.push_back(state.first->insert(entity{ { 0, 0, 0 }, { 1, 1, 1 }, static_cast<std::uint32_t>(i) }));
+				}
+				return state;
+			},
+			[](auto& state)
+			{
+				auto& [map, handles] = state;
+
+				std::uint32_t sum = 0;
+				for (const auto handle : handles)
+				{
+					sum += (*map)[handle].flags;
+				}
+				bench::do_not_optimize(sum);
+
+				for (std::size_t i = 0; i < handles.size(); i += 4)
+				{
+					map->erase(handles[i]);
+					handles[i] = map->insert(entity{ { 0, 0, 0 }, { 1, 1, 1 }, static_cast<std::uint32_t>(i) });
+				}
+			});
+	}
+
+	template <std::size_t Size>
+	void run_unordered_map(bench::runner& runner)
+	{
+		using map_type = std::unordered_map<std::uint32_t, entity>;
+
+		runner.run("std::unordered_map/frame/" + std::to_string(Size), Size,
+			[]
+			{
+				auto state = std::make_pair(std::make_unique<map_type>(), std::vector<std::uint32_t>());
+				for (std::uint32_t i = 0; i < Size; ++i)
+				{
+					state.first->emplace(i, entity{ { 0, 0, 0 }, { 1, 1, 1 }, i });
+					state.second.push_back(i);
+				}
+				return state;
+			},
+			[](auto& state)
+			{
+				auto& [map, ids] = state;
+
+				std::uint32_t sum = 0;
+				for (const std::uint32_t id : ids)
+				{
+					sum += map->find(id)->second.flags;
+				}
+				bench::do_not_optimize(sum);
+
+				std::uint32_t next_id = static_cast<std::uint32_t>(Size);
+				for (std::size_t i = 0; i < ids.size(); i += 4)
+				{
+					map->erase(ids[i]);
+					ids[i] = next_id++;
+					map->emplace(ids[i], entity{ { 0, 0, 0 }, { 1, 1, 1 }, ids[i] });
+				}
+			});
+	}
+}
+
+int main(int argc, char** argv)
+{
+	bench::runner runner(argc > 1 ? argv[1] : "");
+
+	if (!runner.counters_available())
+	{
+		std::printf("perf_event_open unavailable, reporting time only\n");
+	}
+
+	runner.print_header();
+
+	run_slot_map<1024>(runner);
+	run_unordered_map<1024>(runner);
+	run_slot_map<65536>(runner);
+	run_unordered_map<65536>(runner);
+}
@@ -0,0 +1,84 @@
+// A kernel touching two fields out of eight, over static_vector<particle> (array of structs) and static_soa_vector (structure of arrays).
+//
+// Build (from the repository root):
+//   g++ -std=c++20 -O2 -DNDEBUG -Iinc bench/soa_vector_benchmark.cpp -o soa_vector_benchmark
+//   cl /std:c++latest /O2 /EHsc /DNDEBUG /Iinc bench\soa_vector_benchmark.cpp
+//
+// Usage: soa_vector_benchmark [filter]
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include "benchmark.hpp"
+#include "static_soa_vector.hpp"
+
+namespace
+{
+	struct particle
+	{
+		float x, y, z;
+		float vx, vy, vz;
+		float mass;
+		std::uint32_t id;
+	};
+
+	constexpr float dt = 0.01f;
+
+	template <std::size_t Size>
+	void run_integrate(bench::runner& runner)
+	{
+		using aos_type = static_vector<particle, Size>;
+		using soa_type = static_soa_vector<Size, float, float, float, float, float, float, float, std::uint32_t>;
+
+		auto aos = std::make_unique<aos_type>();
+		auto soa = std::make_unique<soa_type>();
+		for (std::uint32_t i = 0; i < Size; ++i)
+		{
+			const float f = static_cast<float>(i);
+			aos->push_back({ f, f, f, 1.0f, 2.0f, 3.0f, 1.0f, i });
+			soa->push_back(f, f, f, 1.0f, 2.0f, 3.0f, 1.0f, i);
+		}
+
+		runner.run("aos static_vector<particle>/x+=vx*dt/" + std::to_string(Size), Size,
+			[] { return 0; },
+			[&](int&)
+			{
+				for (particle& p : *aos)
+				{
+					p.x += p.vx * dt;
+				}
+				bench::do_not_optimize(aos->data());
+			});
+
+		runner.run("soa static_soa_vector/x+=vx*dt/" + std::to_string(Size), Size,
+			[] { return 0; },
+			[&](int&)
+			{
+				const std::span<float> x = soa->template get<0>();
+				const std::span<const float> vx = soa->template get<3>();
+				for (std::size_t i = 0; i < x.size(); ++i)
+				{
+					x[i] += vx[i] * dt;
+				}
+				bench::do_not_optimize(soa->template data<0>());
+			});
+	}
+}
+
+int main(int argc, char** argv)
+{
+	bench::runner runner(argc > 1 ? argv[1] : "");
+
+	if (!runner.counters_available())
+	{
+		std::printf("perf_event_open unavailable, reporting time only\n");
+	}
+
+	runner.print_header();
+
+	run_integrate<1024>(runner);
+	run_integrate<65536>(runner);
+	run_integrate<1048576>(runner);
+}
@@ -0,0 +1,273 @@
+// Throughput and round trip latency of static_spsc_queue between two threads, against a mutex protected std::deque.
+// The producer runs on the calling thread and the consumer on a second one, pinned to different cores where the platform allows it.
+//
+// Build (from the repository root):
+//   g++ -std=c++20 -O2 -DNDEBUG -pthread -Iinc bench/spsc_queue_benchmark.cpp -o spsc_queue_benchmark
+//   cl /std:c++latest /O2 /EHsc /DNDEBUG /Iinc bench\spsc_queue_benchmark.cpp
+//
+// Usage: spsc_queue_benchmark [filter]
+
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+
+#include "benchmark.hpp"
+#include "static_spsc_queue.hpp"
+
+namespace
+{
+	void pin_current_thread(unsigned core) noexcept
+	{
+		if (std::thread::hardware_concurrency() <= core)
+		{
+			return;
+		}
+
+#if defined(__linux__)
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		CPU_SET(core, &set);
+		pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#elif defined(_WIN32)
+		SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR{ 1 } << core);
+#endif
+	}
+
+	// Busy waiting is what the queue is made for when both threads own a core, but with fewer cores than threads
+	// the other side can only make progress if we give the core up.
+	void wait_a_bit() noexcept
+	{
+		static const bool oversubscribed = std::thread::hardware_concurrency() < 2;
+
+		if (oversubscribed)
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	// A thread pinned to the second core running body, joined on destruction.
+	class pinned_thread
+	{
+	public:
+		template <typename Body>
+		explicit pinned_thread(Body body)
+			: _thread([body]() mutable
+			{
+				pin_current_thread(1);
+				body();
+			})
+		{
+		}
+
+		~pinned_thread()
+		{
+			_thread.join();
+		}
+
+	private:
+		std::thread _thread;
+	};
+
+	// The baseline the queue is meant to replace.
+	template <typename T>
+	class locked_deque
+	{
+	public:
+		bool try_push(const T& value)
+		{
+			std::lock_guard lock(_mutex);
+			_items.push_back(value);
+			return true;
+		}
+
+		bool try_pop(T& value)
+		{
+			std::lock_guard lock(_mutex);
+			if (_items.empty())
+			{
+				return false;
+			}
+			value = _items.front();
+			_items.pop_front();
+			return true;
+		}
+
+	private:
+		std::mutex _mutex;
+		std::deque<T> _items;
+	};
+
+	constexpr std::size_t messages = std::size_t{ 1 } << 20;
+
+	template <typename Queue>
+	void run_throughput(bench::runner& runner, const std::string& name)
+	{
+		runner.run(name + "/throughput", messages,
+			[] { return std::make_unique<Queue>(); },
+			[](auto& queue)
+			{
+				pinned_thread consumer([&]
+				{
+					std::uint64_t value = 0;
+					std::uint64_t sum = 0;
+					for (std::size_t received = 0; received < messages;)
+					{
+						if (queue->try_pop(value))
+						{
+							sum += value;
+							++received;
+						}
+						else
+						{
+							wait_a_bit();
+						}
+					}
+					bench::do_not_optimize(sum);
+				});
+
+				for (std::uint64_t i = 0; i < messages;)
+				{
+					if (queue->try_push(i))
+					{
+						++i;
+					}
+					else
+					{
+						wait_a_bit();
+					}
+				}
+			});
+	}
+
+	template <std::size_t Capacity, std::size_t Batch>
+	void run_batched_throughput(bench::runner& runner)
+	{
+		using queue_type = static_spsc_queue<std::uint64_t, Capacity>;
+
+		runner.run("static_spsc_queue<" + std::to_string(Capacity) + ">/batch " + std::to_string(Batch) + "/throughput", messages,
+			[] { return std::make_unique<queue_type>(); },
+			[](auto& queue)
+			{
+				pinned_thread consumer([&]
+				{
+					std::uint64_t sum = 0;
+					for (std::size_t received = 0; received < messages;)
+					{
+						const std::size_t count = queue->consume_n(Batch, [&](std::span<std::uint64_t> run)
+						{
+							for (const std::uint64_t value : run)
+							{
+								sum += value;
+							}
+						});
+
+						received += count;
+						if (count == 0)
+						{
+							wait_a_bit();
+						}
+					}
+					bench::do_not_optimize(sum);
+				});
+
+				std::uint64_t batch[Batch];
+				for (std::uint64_t sent = 0; sent < messages;)
+				{
+					for (std::size_t i = 0; i < Batch; ++i)
+					{
+						batch[i] = sent + i;
+					}
+
+					const std::size_t count = queue->push_n(std::span<const std::uint64_t>(batch, std::min<std::size_t>(Batch, messages - sent)));
+					sent += count;
+					if (count == 0)
+					{
+						wait_a_bit();
+					}
+				}
+			});
+	}
+
+	// One message goes out on one queue and comes back on the other, the reported time is a full round trip.
+	template <typename Queue>
+	void run_round_trip(bench::runner& runner, const std::string& name)
+	{
+		constexpr std::size_t round_trips = std::size_t{ 1 } << 16;
+
+		runner.run(name + "/round_trip", round_trips,
+			[] { return std::make_pair(std::make_unique<Queue>(), std::make_unique<Queue>()); },
+			[](auto& queues)
+			{
+				auto& [ping, pong] = queues;
+
+				pinned_thread echo([&]
+				{
+					std::uint64_t value = 0;
+					for (std::size_t i = 0; i < round_trips; ++i)
+					{
+						while (!ping->try_pop(value))
+						{
+							wait_a_bit();
+						}
+						while (!pong->try_push(value))
+						{
+							wait_a_bit();
+						}
+					}
+				});
+
+				std::uint64_t value = 0;
+				for (std::uint64_t i = 0; i < round_trips; ++i)
+				{
+					while (!ping->try_push(i))
+					{
+						wait_a_bit();
+					}
+					while (!pong->try_pop(value))
+					{
+						wait_a_bit();
+					}
+				}
+			});
+	}
+}
+
+int main(int argc, char** argv)
+{
+	bench::runner runner(argc > 1 ? argv[1] : "");
+
+	if (!runner.counters_available())
+	{
+		std::printf("perf_event_open unavailable, reporting time only\n");
+	}
+	if (std::thread::hardware_concurrency() < 2)
+	{
+		std::printf("fewer than two cores, threads yield instead of spinning and results are not representative\n");
+	}
+
+	pin_current_thread(0);
+	runner.print_header();
+
+	run_throughput<static_spsc_queue<std::uint64_t, 64>>(runner, "static_spsc_queue<64>");
+	run_throughput<static_spsc_queue<std::uint64_t, 1024>>(runner, "static_spsc_queue<1024>");
+	run_throughput<static_spsc_queue<std::uint64_t, 65536>>(runner, "static_spsc_queue<65536>");
+	run_throughput<locked_deque<std::uint64_t>>(runner, "mutex+std::deque");
+
+	run_batched_throughput<1024, 16>(runner);
+	run_batched_throughput<1024, 64>(runner);
+	run_batched_throughput<65536, 256>(runner);
+
+	run_round_trip<static_spsc_queue<std::uint64_t, 64>>(runner, "static_spsc_queue<64>");
+	run_round_trip<locked_deque<std::uint64_t>>(runner, "mutex+std::deque");
+}
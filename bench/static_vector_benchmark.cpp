@@ -0,0 +1,368 @@
+// Compares static_vector against std::vector (with reserve) and std::array + size across element types and capacities.
+//
+// Build (from the repository root):
+//   g++ -std=c++20 -O2 -DNDEBUG -Iinc bench/static_vector_benchmark.cpp -o static_vector_benchmark
+//   cl /std:c++latest /O2 /EHsc /DNDEBUG /Iinc bench\static_vector_benchmark.cpp
+//
+// Usage: static_vector_benchmark [filter]
+// Only benchmarks whose name contains filter are run, e.g. "static_vector<int, 4096>" or "/insert".
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "static_vector.hpp"
+
+namespace
+{
+	struct pod
+	{
+		int id;
+		float weight;
+		double value;
+	};
+
+	template <typename T>
+	T make_value(std::size_t i)
+	{
+		if constexpr (std::is_same_v<T, std::string>)
+		{
+			// Short enough for the small string optimization, so we measure the container rather than malloc.
+			return "str" + std::to_string(i % 10000);
+		}
+		else if constexpr (std::is_same_v<T, pod>)
+		{
+			return pod{ static_cast<int>(i), static_cast<float>(i) * 0.5f, static_cast<double>(i) * 0.25 };
+		}
+		else
+		{
+			return static_cast<T>(i);
+		}
+	}
+
+	// A value that make_value never returns for indices below count.
+	template <typename T>
+	T missing_value(std::size_t count)
+	{
+		if constexpr (std::is_same_v<T, std::string>)
+			return "missing";
+		else
+			return make_value<T>(count + 1);
+	}
+
+	template <typename T>
+	const char* type_name()
+	{
+		if constexpr (std::is_same_v<T, std::string>)
+			return "string";
+		else if constexpr (std::is_same_v<T, pod>)
+			return "pod";
+		else
+			return "int";
+	}
+
+	// The std::array baseline: every slot is always alive, the size only marks how many are in use.
+	template <typename T, std::size_t Capacity>
+	struct array_vector
+	{
+		std::array<T, Capacity> data{};
+		std::size_t count = 0;
+
+		T* begin() noexcept { return data.data(); }
+		T* end() noexcept { return data.data() + count; }
+		std::size_t size() const noexcept { return count; }
+
+		void push_back(const T& value) { data[count++] = value; }
+		void push_back(T&& value) { data[count++] = std::move(value); }
+
+		template <typename ... Args>
+		void emplace_back(Args&& ... args) { data[count++] = T(std::forward<Args>(args)...); }
+
+		void insert(T* pos, const T& value)
+		{
+			std::move_backward(pos, end(), end() + 1);
+			*pos = value;
+			++count;
+		}
+
+		void erase(T* pos)
+		{
+			std::move(pos + 1, end(), pos);
+			--count;
+		}
+
+		void assign(std::size_t n, const T& value)
+		{
+			std::fill_n(begin(), n, value);
+			count = n;
+		}
+
+		void resize(std::size_t n)
+		{
+			if (n > count)
+			{
+				std::fill(end(), begin() + n, T{});
+			}
+			count = n;
+		}
+
+		void swap(array_vector& other)
+		{
+			std::swap_ranges(begin(), begin() + std::max(count, other.count), other.begin());
+			std::swap(count, other.count);
+		}
+	};
+
+	template <typename Container>
+	struct container_traits;
+
+	template <typename T, std::size_t Capacity>
+	struct container_traits<static_vector<T, Capacity>>
+	{
+		static constexpr std::size_t capacity = Capacity;
+		static constexpr const char* name = "static_vector";
+
+		static std::unique_ptr<static_vector<T, Capacity>> make()
+		{
+			return std::make_unique<static_vector<T, Capacity>>();
+		}
+	};
+
+	template <typename T, std::size_t Capacity>
+	struct container_traits<array_vector<T, Capacity>>
+	{
+		static constexpr std::size_t capacity = Capacity;
+		static constexpr const char* name = "array+size";
+
+		static std::unique_ptr<array_vector<T, Capacity>> make()
+		{
+			return std::make_unique<array_vector<T, Capacity>>();
+		}
+	};
+
+	// std::vector is wrapped so that it carries its capacity in the type like the other two.
+	template <typename T, std::size_t Capacity>
+	struct reserved_vector : std::vector<T>
+	{
+		reserved_vector()
+		{
+			this->reserve(Capacity);
+		}
+	};
+
+	template <typename T, std::size_t Capacity>
+	struct container_traits<reserved_vector<T, Capacity>>
+	{
+		static constexpr std::size_t capacity = Capacity;
+		static constexpr const char* name = "std::vector";
+
+		static std::unique_ptr<reserved_vector<T, Capacity>> make()
+		{
+			return std::make_unique<reserved_vector<T, Capacity>>();
+		}
+	};
+
+	template <typename Container>
+	std::unique_ptr<Container> make_filled(std::size_t count)
+	{
+		using T = std::remove_cvref_t<decltype(*std::declval<Container&>().begin())>;
+
+		auto container = container_traits<Container>::make();
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			container->push_back(make_value<T>(i));
+		}
+		return container;
+	}
+
+	// Raw storage for constructing whole containers in the timed region without running out of stack.
+	template <typename Container>
+	struct raw_slot
+	{
+		alignas(Container) std::byte bytes[sizeof(Container)];
+
+		Container* get() noexcept
+		{
+			return std::launder(reinterpret_cast<Container*>(bytes));
+		}
+	};
+
+	template <typename Container, typename T>
+	void run_container(bench::runner& runner)
+	{
+		using traits = container_traits<Container>;
+		constexpr std::size_t capacity = traits::capacity;
+
+		const std::string prefix = std::string(traits::name) + "<" + type_name<T>() + ", " + std::to_string(capacity) + ">";
+
+		// Bulk operations on small containers are batched so the timer has something to measure.
+		const std::size_t batch = std::max<std::size_t>(1, 4096 / capacity);
+		const std::size_t shifts = std::min<std::size_t>(capacity / 2, 256);
+
+		runner.run(prefix + "/push_back", capacity,
+			[&] { return std::make_pair(container_traits<Container>::make(), make_value<T>(7)); },
+			[&](auto& state)
+			{
+				auto& [container, value] = state;
+				for (std::size_t i = 0; i < capacity; ++i)
+				{
+					container->push_back(value);
+				}
+			});
+
+		runner.run(prefix + "/emplace_back", capacity,
+			[&] { return container_traits<Container>::make(); },
+			[&](auto& container)
+			{
+				for (std::size_t i = 0; i < capacity; ++i)
+				{
+					if constexpr (std::is_same_v<T, pod>)
+						container->emplace_back(pod{ static_cast<int>(i), 1.0f, 2.0 });
+					else if constexpr (std::is_same_v<T, std::string>)
+						container->emplace_back(3, 'x');
+					else
+						container->emplace_back(static_cast<T>(i));
+				}
+			});
+
+		runner.run(prefix + "/insert_middle", shifts,
+			[&] { return make_filled<Container>(capacity / 2); },
+			[&](auto& container)
+			{
+				const T value = make_value<T>(42);
+				for (std::size_t i = 0; i < shifts; ++i)
+				{
+					container->insert(container->begin() + container->size() / 2, value);
+				}
+			});
+
+		runner.run(prefix + "/erase_middle", shifts,
+			[&] { return make_filled<Container>(capacity); },
+			[&](auto& container)
+			{
+				for (std::size_t i = 0; i < shifts; ++i)
+				{
+					container->erase(container->begin() + container->size() / 2);
+				}
+			});
+
+		// Looks for a value that isn't there, so the whole vector is scanned. static_vector's member find is vectorized for arithmetic types.
+		if constexpr (std::equality_comparable<T>)
+		{
+			runner.run(prefix + "/find", batch * capacity,
+				[&] { return make_filled<Container>(capacity); },
+				[&](auto& container)
+				{
+					const T missing = missing_value<T>(capacity);
+					for (std::size_t i = 0; i < batch; ++i)
+					{
+						if constexpr (requires { container->find(missing); })
+							bench::do_not_optimize(container->find(missing));
+						else
+							bench::do_not_optimize(std::find(container->begin(), container->end(), missing));
+					}
+				});
+		}
+
+		runner.run(prefix + "/swap", batch,
+			[&] { return std::make_pair(make_filled<Container>(capacity / 2), make_filled<Container>(capacity / 2)); },
+			[&](auto& state)
+			{
+				for (std::size_t i = 0; i < batch; ++i)
+				{
+					state.first->swap(*state.second);
+				}
+			});
+
+		runner.run(prefix + "/copy_construct", batch,
+			[&] { return std::make_pair(make_filled<Container>(capacity), std::make_unique<raw_slot<Container>>()); },
+			[&](auto& state)
+			{
+				auto& [source, slot] = state;
+				for (std::size_t i = 0; i < batch; ++i)
+				{
+					Container* copy = ::new (static_cast<void*>(slot->bytes)) Container(*source);
+					bench::do_not_optimize(copy);
+					copy->~Container();
+				}
+			});
+
+		runner.run(prefix + "/move_construct", 2 * batch,
+			[&] { return std::make_pair(make_filled<Container>(capacity), std::make_unique<raw_slot<Container>>()); },
+			[&](auto& state)
+			{
+				auto& [source, slot] = state;
+				for (std::size_t i = 0; i < batch; ++i)
+				{
+					Container* moved = ::new (static_cast<void*>(slot->bytes)) Container(std::move(*source));
+					source->~Container();
+					::new (static_cast<void*>(source.get())) Container(std::move(*moved));
+					moved->~Container();
+				}
+			});
+
+		runner.run(prefix + "/assign", 2 * batch,
+			[&] { return make_filled<Container>(capacity / 2); },
+			[&](auto& container)
+			{
+				const T value = make_value<T>(3);
+				for (std::size_t i = 0; i < batch; ++i)
+				{
+					container->assign(capacity, value);
+					container->assign(capacity / 4, value);
+				}
+			});
+
+		runner.run(prefix + "/resize", 2 * batch,
+			[&] { return container_traits<Container>::make(); },
+			[&](auto& container)
+			{
+				for (std::size_t i = 0; i < batch; ++i)
+				{
+					container->resize(capacity);
+					container->resize(0);
+				}
+			});
+	}
+
+	template <typename T, std::size_t Capacity>
+	void run_capacity(bench::runner& runner)
+	{
+		run_container<static_vector<T, Capacity>, T>(runner);
+		run_container<reserved_vector<T, Capacity>, T>(runner);
+		run_container<array_vector<T, Capacity>, T>(runner);
+	}
+
+	template <typename T>
+	void run_type(bench::runner& runner)
+	{
+		run_capacity<T, 8>(runner);
+		run_capacity<T, 64>(runner);
+		run_capacity<T, 512>(runner);
+		run_capacity<T, 4096>(runner);
+		run_capacity<T, 65536>(runner);
+		run_capacity<T, 1 << 20>(runner);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	bench::runner runner(argc > 1 ? argv[1] : "");
+
+	if (!runner.counters_available())
+	{
+		std::printf("perf_event_open unavailable, reporting time only\n");
+	}
+
+	runner.print_header();
+
+	run_type<int>(runner);
+	run_type<pod>(runner);
+	run_type<std::string>(runner);
+}
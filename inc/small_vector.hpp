@@ -0,0 +1,905 @@
+#pragma once
+
+#include "static_vector.hpp"
+
+#include <compare>
+#include <memory>
+
+// A vector that keeps up to N elements in an inline buffer, laid out like static_vector's, and only moves them to memory from
+// Allocator once it outgrows it. Sizing N for the common case keeps most instances allocation free without capping the worst case.
+// The iterators are static_vector's, and the two containers convert cheaply into each other.
+template <typename T, std::size_t N, typename Allocator = std::allocator<T>>
+class small_vector
+{
+	static_assert(N > 0, "small_vector needs an inline capacity, use std::vector otherwise");
+	static_assert(std::is_same_v<typename std::allocator_traits<Allocator>::value_type, T>);
+
+	using alloc_traits = std::allocator_traits<Allocator>;
+
+public:
+
+	using value_type = T;
+	using allocator_type = Allocator;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = value_type&;
+	using const_reference = const value_type&;
+	using pointer = T*;
+	using const_pointer = const T*;
+
+	using iterator = typename static_vector<T, N>::iterator;
+	using const_iterator = typename static_vector<T, N>::const_iterator;
+	using reverse_iterator = typename static_vector<T, N>::reverse_iterator;
+	using const_reverse_iterator = typename static_vector<T, N>::const_reverse_iterator;
+
+	constexpr small_vector() noexcept (std::is_nothrow_default_constructible_v<Allocator>) = default;
+
+	constexpr explicit small_vector(const Allocator& allocator) noexcept
+		: _allocator(allocator)
+	{
+	}
+
+	constexpr small_vector(std::size_t count, const T& value, const Allocator& allocator = Allocator())
+		requires (std::is_copy_constructible_v<T>)
+		: _allocator(allocator)
+	{
+		reserve(count);
+		std::uninitialized_fill_n(_begin, count, value);
+		_size = count;
+	}
+
+	constexpr explicit small_vector(std::size_t count, const Allocator& allocator = Allocator())
+		requires (std::is_default_constructible_v<T>)
+		: _allocator(allocator)
+	{
+		reserve(count);
+		std::uninitialized_value_construct_n(_begin, count);
+		_size = count;
+	}
+
+	template <typename Iterator> requires (std::input_iterator<Iterator> && std::constructible_from<T, std::iter_reference_t<Iterator>>)
+	constexpr small_vector(Iterator first, Iterator last, const Allocator& allocator = Allocator())
+		: _allocator(allocator)
+	{
+		append(first, last);
+	}
+
+	constexpr small_vector(std::initializer_list<T> values, const Allocator& allocator = Allocator())
+		: _allocator(allocator)
+	{
+		append(values.begin(), values.end());
+	}
+
+	constexpr small_vector(const small_vector& other) requires (std::is_copy_constructible_v<T>)
+		: _allocator(alloc_traits::select_on_container_copy_construction(other._allocator))
+	{
+		append(other.begin(), other.end());
+	}
+
+	constexpr small_vector(small_vector&& other) noexcept (std::is_nothrow_move_constructible_v<T> || is_trivially_relocatable_v<T>)
+		: _allocator(std::move(other._allocator))
+	{
+		steal(other);
+	}
+
+	template <std::size_t Capacity, typename Policy> requires (std::is_copy_constructible_v<T>)
+	constexpr explicit small_vector(const static_vector<T, Capacity, Policy>& other, const Allocator& allocator = Allocator())
+		: _allocator(allocator)
+	{
+		append(other.begin(), other.end());
+	}
+
+	// Takes over the elements of other, relocating them when T allows it. other is left empty.
+	template <std::size_t Capacity, typename Policy> requires (std::is_move_constructible_v<T>)
+	constexpr explicit small_vector(static_vector<T, Capacity, Policy>&& other, const Allocator& allocator = Allocator())
+		: _allocator(allocator)
+	{
+		reserve(other.size());
+
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			static_vector_detail::relocate_n(other.data(), other.size(), _begin);
+		}
+		else
+		{
+			std::uninitialized_move_n(other.begin(), other.size(), begin());
+			std::destroy_n(other.begin(), other.size());
+		}
+
+		_size = other.size();
+		other._size = 0;
+	}
+
+	constexpr ~small_vector()
+	{
+		std::destroy_n(_begin, _size);
+		release();
+	}
+
+	constexpr small_vector& operator=(const small_vector& other) requires (std::is_copy_constructible_v<T> && std::is_copy_assignable_v<T>)
+	{
+		if (this != &other)
+		{
+			if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+			{
+				if (_allocator != other._allocator)
+				{
+					clear();
+					release();
+				}
+				_allocator = other._allocator;
+			}
+
+			assign(other.begin(), other.end());
+		}
+
+		return *this;
+	}
+
+	constexpr small_vector& operator=(small_vector&& other) noexcept ((std::is_nothrow_move_constructible_v<T> || is_trivially_relocatable_v<T>) &&
+		(alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value))
+	{
+		if (this == &other)
+		{
+			return *this;
+		}
+
+		if constexpr (!alloc_traits::propagate_on_container_move_assignment::value && !alloc_traits::is_always_equal::value)
+		{
+			// Memory from another allocator can't be adopted, so the elements are moved one by one instead.
+			if (_allocator != other._allocator)
+			{
+				assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+				other.clear();
+				return *this;
+			}
+		}
+
+		clear();
+		release();
+
+		if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+		{
+			_allocator = std::move(other._allocator);
+		}
+
+		steal(other);
+
+		return *this;
+	}
+
+	constexpr small_vector& operator=(std::initializer_list<T> values)
+	{
+		assign(values.begin(), values.end());
+		return *this;
+	}
+
+	template <typename Iterator> requires (std::input_iterator<Iterator> && std::constructible_from<T, std::iter_reference_t<Iterator>>)
+	constexpr void assign(Iterator first, Iterator last)
+	{
+		if constexpr (std::forward_iterator<Iterator>)
+		{
+			const std::size_t count = static_cast<std::size_t>(std::distance(first, last));
+
+			if (count > _capacity)
+			{
+				clear();
+				reserve(count);
+			}
+		}
+
+		iterator it = begin();
+		for (; first != last && it != end(); ++first, ++it)
+		{
+			*it = *first;
+		}
+
+		if (it != end())
+		{
+			std::destroy(it, end());
+			_size = static_cast<std::size_t>(it - begin());
+		}
+		else
+		{
+			append(first, last);
+		}
+	}
+
+	constexpr void assign(std::size_t count, const T& value)
+	{
+		if (count > _capacity)
+		{
+			const T copy = value;
+			clear();
+			reserve(count);
+			std::uninitialized_fill_n(_begin, count, copy);
+		}
+		else if (count > _size)
+		{
+			std::fill_n(_begin, _size, value);
+			std::uninitialized_fill_n(_begin + _size, count - _size, value);
+		}
+		else
+		{
+			std::fill_n(_begin, count, value);
+			std::destroy(_begin + count, _begin + _size);
+		}
+
+		_size = count;
+	}
+
+	constexpr void assign(std::initializer_list<T> values)
+	{
+		assign(values.begin(), values.end());
+	}
+
+	// Moves the elements into a static_vector, relocating them when T allows it. This vector is left empty.
+	template <std::size_t Capacity, typename Policy = static_vector_default_policy> requires (std::is_move_constructible_v<T>)
+	constexpr static_vector<T, Capacity, Policy> to_static_vector() &&
+	{
+		static_vector<T, Capacity, Policy> result;
+		const std::size_t count = result.fit(_size, Capacity, "Static vector lacks the capacity to store the data of the other vector!");
+
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			static_vector_detail::relocate_n(_begin, count, result.data());
+			std::destroy(_begin + count, _begin + _size);
+		}
+		else
+		{
+			std::uninitialized_move_n(_begin, count, result.data());
+			std::destroy_n(_begin, _size);
+		}
+
+		result._size = static_cast<typename static_vector<T, Capacity, Policy>::size_field_type>(count);
+		_size = 0;
+
+		return result;
+	}
+
+	template <std::size_t Capacity, typename Policy = static_vector_default_policy> requires (std::is_copy_constructible_v<T>)
+	constexpr static_vector<T, Capacity, Policy> to_static_vector() const&
+	{
+		return static_vector<T, Capacity, Policy>(cbegin(), cend());
+	}
+
+	constexpr allocator_type get_allocator() const noexcept
+	{
+		return _allocator;
+	}
+
+	constexpr iterator begin() noexcept
+	{
+		return iterator(_begin);
+	}
+	constexpr iterator end() noexcept
+	{
+		return iterator(_begin + _size);
+	}
+	constexpr const_iterator begin() const noexcept
+	{
+		return const_iterator(_begin);
+	}
+	constexpr const_iterator end() const noexcept
+	{
+		return const_iterator(_begin + _size);
+	}
+	constexpr const_iterator cbegin() const noexcept
+	{
+		return const_iterator(_begin);
+	}
+	constexpr const_iterator cend() const noexcept
+	{
+		return const_iterator(_begin + _size);
+	}
+	constexpr reverse_iterator rbegin() noexcept
+	{
+		return reverse_iterator(_begin + _size);
+	}
+	constexpr reverse_iterator rend() noexcept
+	{
+		return reverse_iterator(_begin);
+	}
+	constexpr const_reverse_iterator rbegin() const noexcept
+	{
+		return const_reverse_iterator(_begin + _size);
+	}
+	constexpr const_reverse_iterator rend() const noexcept
+	{
+		return const_reverse_iterator(_begin);
+	}
+	constexpr const_reverse_iterator crbegin() const noexcept
+	{
+		return const_reverse_iterator(_begin + _size);
+	}
+	constexpr const_reverse_iterator crend() const noexcept
+	{
+		return const_reverse_iterator(_begin);
+	}
+
+	constexpr reference operator[] (std::size_t index) noexcept
+	{
+		static_vector_detail::debug_check(index < _size, "small_vector index out of bounds");
+		return _begin[index];
+	}
+
+	constexpr const_reference operator[] (std::size_t index) const noexcept
+	{
+		static_vector_detail::debug_check(index < _size, "small_vector index out of bounds");
+		return _begin[index];
+	}
+
+	constexpr reference at(std::size_t index)
+	{
+		if (index >= _size) [[unlikely]]
+		{
+			static_vector_default_policy::out_of_range("Index out of bounds!");
+		}
+
+		return _begin[index];
+	}
+
+	constexpr const_reference at(std::size_t index) const
+	{
+		if (index >= _size) [[unlikely]]
+		{
+			static_vector_default_policy::out_of_range("Index out of bounds!");
+		}
+
+		return _begin[index];
+	}
+
+	constexpr reference front() noexcept
+	{
+		return _begin[0];
+	}
+
+	constexpr const_reference front() const noexcept
+	{
+		return _begin[0];
+	}
+
+	constexpr reference back() noexcept
+	{
+		return _begin[_size - 1];
+	}
+
+	constexpr const_reference back() const noexcept
+	{
+		return _begin[_size - 1];
+	}
+
+	constexpr pointer data() noexcept
+	{
+		return _begin;
+	}
+
+	constexpr const_pointer data() const noexcept
+	{
+		return _begin;
+	}
+
+	static constexpr std::size_t npos = static_vector_detail::not_found;
+
+	// The same vectorized searches as static_vector's, reading up to the current capacity.
+	constexpr iterator find(const T& value) noexcept (static_vector_detail::is_nothrow_equality_comparable_v<T>) requires (std::equality_comparable<T>)
+	{
+		const std::size_t index = static_vector_detail::find_index(_begin, _size, _capacity, value);
+		return index == npos ? end() : begin() + index;
+	}
+
+	constexpr const_iterator find(const T& value) const noexcept (static_vector_detail::is_nothrow_equality_comparable_v<T>) requires (std::equality_comparable<T>)
+	{
+		const std::size_t index = static_vector_detail::find_index(_begin, _size, _capacity, value);
+		return index == npos ? cend() : cbegin() + index;
+	}
+
+	constexpr bool contains(const T& value) const noexcept (static_vector_detail::is_nothrow_equality_comparable_v<T>) requires (std::equality_comparable<T>)
+	{
+		return static_vector_detail::find_index(_begin, _size, _capacity, value) != npos;
+	}
+
+	constexpr std::size_t count(const T& value) const noexcept (static_vector_detail::is_nothrow_equality_comparable_v<T>) requires (std::equality_comparable<T>)
+	{
+		return static_vector_detail::count_equal(_begin, _size, _capacity, value);
+	}
+
+	constexpr std::size_t index_of(const T& value) const noexcept (static_vector_detail::is_nothrow_equality_comparable_v<T>) requires (std::equality_comparable<T>)
+	{
+		return static_vector_detail::find_index(_begin, _size, _capacity, value);
+	}
+
+	constexpr std::size_t size() const noexcept
+	{
+		return _size;
+	}
+
+	constexpr std::size_t capacity() const noexcept
+	{
+		return _capacity;
+	}
+
+	static constexpr std::size_t inline_capacity() noexcept
+	{
+		return N;
+	}
+
+	constexpr std::size_t max_size() const noexcept
+	{
+		return alloc_traits::max_size(_allocator);
+	}
+
+	constexpr bool empty() const noexcept
+	{
+		return _size == 0;
+	}
+
+	// True while the elements live in the inline buffer.
+	constexpr bool is_inline() const noexcept
+	{
+		return _begin == inline_data();
+	}
+
+	constexpr void reserve(std::size_t new_capacity)
+	{
+		if (new_capacity > _capacity)
+		{
+			reallocate(new_capacity);
+		}
+	}
+
+	// Moves the elements back into the inline buffer if they fit, or into an exactly sized allocation otherwise.
+	constexpr void shrink_to_fit()
+	{
+		if (is_inline() || _size == _capacity)
+		{
+			return;
+		}
+
+		if (_size <= N)
+		{
+			T* const heap = _begin;
+			const std::size_t heap_capacity = _capacity;
+
+			transfer(heap, _size, inline_data());
+			_begin = inline_data();
+			_capacity = N;
+			alloc_traits::deallocate(_allocator, heap, heap_capacity);
+		}
+		else
+		{
+			reallocate(_size);
+		}
+	}
+
+	constexpr void push_back(const T& val)
+	{
+		emplace_back(val);
+	}
+
+	constexpr void push_back(T&& val)
+	{
+		emplace_back(std::move(val));
+	}
+
+	template <typename ... Args>
+	constexpr reference emplace_back(Args&& ... args)
+	{
+		if (_size == _capacity) [[unlikely]]
+		{
+			return grow_and_emplace_back(std::forward<Args>(args)...);
+		}
+
+		T* const element = std::construct_at(_begin + _size, std::forward<Args>(args)...);
+		_size++;
+
+		return *element;
+	}
+
+	constexpr void pop_back()
+	{
+		if (empty()) [[unlikely]]
+		{
+			static_vector_default_policy::out_of_range("Can't pop from empty vector!");
+		}
+
+		std::destroy_at(_begin + _size - 1);
+		_size--;
+	}
+
+	constexpr void pop_back(std::size_t count)
+	{
+		if (count > _size) [[unlikely]]
+		{
+			static_vector_default_policy::out_of_range("Can't pop more elements than the vector holds!");
+		}
+
+		truncate(_size - count);
+	}
+
+	constexpr void truncate(std::size_t count) noexcept
+	{
+		if (count < _size)
+		{
+			std::destroy(_begin + count, _begin + _size);
+			_size = count;
+		}
+	}
+
+	constexpr void clear() noexcept
+	{
+		std::destroy_n(_begin, _size);
+		_size = 0;
+	}
+
+	constexpr void resize(std::size_t new_size)
+	{
+		if (new_size > _size)
+		{
+			reserve(new_size);
+			std::uninitialized_value_construct_n(_begin + _size, new_size - _size);
+		}
+		else
+		{
+			std::destroy(_begin + new_size, _begin + _size);
+		}
+
+		_size = new_size;
+	}
+
+	constexpr void resize(std::size_t new_size, const T& value)
+	{
+		if (new_size > _size)
+		{
+			const T copy = value;
+			reserve(new_size);
+			std::uninitialized_fill_n(_begin + _size, new_size - _size, copy);
+		}
+		else
+		{
+			std::destroy(_begin + new_size, _begin + _size);
+		}
+
+		_size = new_size;
+	}
+
+	// Inserting appends the new elements and rotates them into place, which only needs the vector to grow once.
+	template <typename ... Args>
+	constexpr iterator emplace(const_iterator pos, Args&& ... args)
+	{
+		const std::size_t index = static_cast<std::size_t>(pos - cbegin());
+		emplace_back(std::forward<Args>(args)...);
+		std::rotate(_begin + index, _begin + _size - 1, _begin + _size);
+		return begin() + index;
+	}
+
+	constexpr iterator insert(const_iterator pos, const T& value)
+	{
+		return emplace(pos, value);
+	}
+
+	constexpr iterator insert(const_iterator pos, T&& value)
+	{
+		return emplace(pos, std::move(value));
+	}
+
+	constexpr iterator insert(const_iterator pos, std::size_t count, const T& value)
+	{
+		const std::size_t index = static_cast<std::size_t>(pos - cbegin());
+		const T copy = value;
+
+		if (_size + count > _capacity)
+		{
+			reallocate(grown_capacity(_size + count));
+		}
+
+		std::uninitialized_fill_n(_begin + _size, count, copy);
+		_size += count;
+		std::rotate(_begin + index, _begin + _size - count, _begin + _size);
+
+		return begin() + index;
+	}
+
+	template <typename Iterator> requires (std::input_iterator<Iterator> && std::constructible_from<T, std::iter_reference_t<Iterator>>)
+	constexpr iterator insert(const_iterator pos, Iterator first, Iterator last)
+	{
+		const std::size_t index = static_cast<std::size_t>(pos - cbegin());
+		const std::size_t old_size = _size;
+
+		append(first, last);
+		std::rotate(_begin + index, _begin + old_size, _begin + _size);
+
+		return begin() + index;
+	}
+
+	constexpr iterator insert(const_iterator pos, std::initializer_list<T> values)
+	{
+		return insert(pos, values.begin(), values.end());
+	}
+
+	template <std::ranges::input_range Range> requires (std::constructible_from<T, std::ranges::range_reference_t<Range>>)
+	constexpr iterator insert_range(const_iterator pos, Range&& range)
+	{
+		const std::size_t index = static_cast<std::size_t>(pos - cbegin());
+		const std::size_t old_size = _size;
+
+		append(std::ranges::begin(range), std::ranges::end(range));
+		std::rotate(_begin + index, _begin + old_size, _begin + _size);
+
+		return begin() + index;
+	}
+
+	template <std::ranges::input_range Range> requires (std::constructible_from<T, std::ranges::range_reference_t<Range>>)
+	constexpr void append_range(Range&& range)
+	{
+		append(std::ranges::begin(range), std::ranges::end(range));
+	}
+
+	constexpr iterator erase(const_iterator pos)
+	{
+		return erase(pos, pos + 1);
+	}
+
+	// Erases the elements in [first, last).
+	constexpr iterator erase(const_iterator first, const_iterator last)
+	{
+		T* const position = _begin + (first - cbegin());
+
+		// Moving the tail onto itself would leave it moved-from.
+		if (first == last)
+		{
+			return iterator(position);
+		}
+
+		T* const new_end = std::move(_begin + (last - cbegin()), _begin + _size, position);
+
+		std::destroy(new_end, _begin + _size);
+		_size = static_cast<std::size_t>(new_end - _begin);
+
+		return iterator(position);
+	}
+
+	// Erases the element at pos by moving the last element into its place.
+	constexpr iterator erase_unordered(const_iterator pos)
+	{
+		T* const position = _begin + (pos - cbegin());
+		T* const last = _begin + _size - 1;
+
+		if (position != last)
+		{
+			*position = std::move(*last);
+		}
+
+		std::destroy_at(last);
+		_size--;
+
+		return iterator(position);
+	}
+
+	constexpr void swap(small_vector& other) noexcept ((std::is_nothrow_move_constructible_v<T> || is_trivially_relocatable_v<T>) &&
+		(alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value))
+	{
+		if (this != &other)
+		{
+			small_vector temporary(std::move(other));
+			other = std::move(*this);
+			*this = std::move(temporary);
+		}
+	}
+
+private:
+
+	template <typename U, std::size_t M, typename Other_Allocator>
+	friend class small_vector;
+
+	constexpr T* inline_data() noexcept
+	{
+		return std::launder(reinterpret_cast<T*>(_inline));
+	}
+
+	constexpr const T* inline_data() const noexcept
+	{
+		return std::launder(reinterpret_cast<const T*>(_inline));
+	}
+
+	// Moves count elements from source to uninitialized destination and ends the lifetime of the sources.
+	static constexpr void transfer(T* source, std::size_t count, T* destination) noexcept (std::is_nothrow_move_constructible_v<T> || is_trivially_relocatable_v<T>)
+	{
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			static_vector_detail::relocate_n(source, count, destination);
+		}
+		else
+		{
+			if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>)
+			{
+				std::uninitialized_move_n(source, count, destination);
+			}
+			else
+			{
+				std::uninitialized_copy_n(source, count, destination);
+			}
+			std::destroy_n(source, count);
+		}
+	}
+
+	// Takes over other's heap buffer, or moves its inline elements into ours. other is left empty and inline.
+	constexpr void steal(small_vector& other) noexcept (std::is_nothrow_move_constructible_v<T> || is_trivially_relocatable_v<T>)
+	{
+		if (other.is_inline())
+		{
+			transfer(other._begin, other._size, inline_data());
+			_begin = inline_data();
+			_capacity = N;
+		}
+		else
+		{
+			_begin = other._begin;
+			_capacity = other._capacity;
+			other._begin = other.inline_data();
+			other._capacity = N;
+		}
+
+		_size = other._size;
+		other._size = 0;
+	}
+
+	constexpr void release() noexcept
+	{
+		if (!is_inline())
+		{
+			alloc_traits::deallocate(_allocator, _begin, _capacity);
+			_begin = inline_data();
+			_capacity = N;
+		}
+	}
+
+	constexpr std::size_t grown_capacity(std::size_t required) const
+	{
+		if (required > max_size()) [[unlikely]]
+		{
+			static_vector_default_policy::capacity_exceeded("small_vector would exceed its allocator's max_size!");
+		}
+
+		return std::max(required, std::min(_capacity * 2, max_size()));
+	}
+
+	// Frees a fresh allocation if filling it throws.
+	struct allocation_guard
+	{
+		Allocator& allocator;
+		T* memory;
+		std::size_t capacity;
+
+		constexpr ~allocation_guard()
+		{
+			if (memory != nullptr)
+			{
+				alloc_traits::deallocate(allocator, memory, capacity);
+			}
+		}
+	};
+
+	// Destroys an element built ahead of the others if moving those throws.
+	struct element_guard
+	{
+		T* element;
+
+		constexpr ~element_guard()
+		{
+			if (element != nullptr)
+			{
+				std::destroy_at(element);
+			}
+		}
+	};
+
+	constexpr void reallocate(std::size_t new_capacity)
+	{
+		allocation_guard guard{ _allocator, alloc_traits::allocate(_allocator, new_capacity), new_capacity };
+
+		transfer(_begin, _size, guard.memory);
+		release();
+
+		_begin = guard.memory;
+		_capacity = new_capacity;
+		guard.memory = nullptr;
+	}
+
+	template <typename ... Args>
+	constexpr reference grow_and_emplace_back(Args&& ... args)
+	{
+		const std::size_t new_capacity = grown_capacity(_size + 1);
+		allocation_guard guard{ _allocator, alloc_traits::allocate(_allocator, new_capacity), new_capacity };
+
+		// Built before the old elements are moved, the arguments might refer to one of them.
+		T* const element = std::construct_at(guard.memory + _size, std::forward<Args>(args)...);
+		element_guard built{ element };
+		transfer(_begin, _size, guard.memory);
+		built.element = nullptr;
+		release();
+
+		_begin = guard.memory;
+		_capacity = new_capacity;
+		guard.memory = nullptr;
+		_size++;
+
+		return *element;
+	}
+
+	template <typename Iterator, typename Sentinel>
+	constexpr void append(Iterator first, Sentinel last)
+	{
+		if constexpr (std::forward_iterator<Iterator>)
+		{
+			const std::size_t count = static_cast<std::size_t>(std::ranges::distance(first, last));
+
+			if (_size + count > _capacity)
+			{
+				reallocate(grown_capacity(_size + count));
+			}
+
+			std::uninitialized_copy_n(first, count, _begin + _size);
+			_size += count;
+		}
+		else
+		{
+			for (; first != last; ++first)
+			{
+				emplace_back(*first);
+			}
+		}
+	}
+
+	[[no_unique_address]] Allocator _allocator{};
+	T* _begin = inline_data();
+	std::size_t _size = 0;
+	std::size_t _capacity = N;
+	// Same storage as static_vector: raw, suitably aligned and only constructed into as elements are added.
+	std::aligned_storage_t<sizeof(T), alignof(T)> _inline[N];
+};
+
+template <typename T, std::size_t lc, typename la, std::size_t rc, typename ra> requires (std::equality_comparable<T>)
+constexpr bool operator==(const small_vector<T, lc, la>& lhs, const small_vector<T, rc, ra>& rhs) noexcept
+{
+	return std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+}
+
+template <typename T, std::size_t lc, typename la, std::size_t rc, typename ra> requires (std::equality_comparable<T>)
+constexpr auto operator<=>(const small_vector<T, lc, la>& lhs, const small_vector<T, rc, ra>& rhs) noexcept
+{
+	return std::lexicographical_compare_three_way(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+}
+
+template <typename T, std::size_t N, typename Allocator>
+constexpr void swap(small_vector<T, N, Allocator>& lhs, small_vector<T, N, Allocator>& rhs) noexcept (noexcept(lhs.swap(rhs)))
+{
+	lhs.swap(rhs);
+}
+
+template <typename T, std::size_t N, typename Allocator, typename U> requires (std::equality_comparable_with<T, U>)
+constexpr std::size_t erase(small_vector<T, N, Allocator>& vector, const U& value)
+{
+	T* const end = vector.data() + vector.size();
+	const std::size_t removed = static_cast<std::size_t>(end - std::remove(vector.data(), end, value));
+	vector.truncate(vector.size() - removed);
+	return removed;
+}
+
+template <typename T, std::size_t N, typename Allocator, typename Predicate> requires (std::predicate<Predicate&, T&>)
+constexpr std::size_t erase_if(small_vector<T, N, Allocator>& vector, Predicate predicate)
+{
+	T* const end = vector.data() + vector.size();
+	const std::size_t removed = static_cast<std::size_t>(end - std::remove_if(vector.data(), end, std::ref(predicate)));
+	vector.truncate(vector.size() - removed);
+	return removed;
+}
+
+namespace small_vector_static_assertions
+{
+	// The inline buffer is the same as a static_vector's, plus the heap pointer, size and capacity.
+	static_assert(sizeof(small_vector<int, 8>) == sizeof(int) * 8 + sizeof(int*) + 2 * sizeof(std::size_t));
+	static_assert(std::is_same_v<small_vector<int, 8>::iterator, static_vector<int, 8>::iterator>);
+	static_assert(std::is_nothrow_move_constructible_v<small_vector<std::unique_ptr<int>, 4>>);
+	static_assert(std::is_nothrow_swappable_v<small_vector<int, 4>>);
+}
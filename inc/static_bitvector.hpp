@@ -0,0 +1,720 @@
+#pragma once
+
+#include "static_vector.hpp"
+
+#include <span>
+
+// A fixed capacity vector of flags packed 64 to a word, for masks where static_vector<bool, N> would spend a byte per flag.
+// It is a separate type rather than a static_vector<bool> specialization, so static_vector<bool> keeps its contiguous bool storage.
+//
+// Elements are accessed through a reference proxy, like std::vector<bool>. count(), find_first(), find_next() and the bitwise
+// operators work a word at a time. The bits past size() are always zero, which is what lets them skip masking the last word.
+// Capacity and error handling follow static_vector: overflows are reported to Policy::capacity_exceeded, bad accesses to Policy::out_of_range.
+template <std::size_t Capacity, typename Policy = static_vector_default_policy>
+class static_bitvector
+{
+public:
+
+	using word_type = std::uint64_t;
+
+	static constexpr std::size_t bits_per_word = std::numeric_limits<word_type>::digits;
+	static constexpr std::size_t word_count = (Capacity + bits_per_word - 1) / bits_per_word;
+
+	// Returned by the searches when there is no such bit.
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+	class reference
+	{
+	public:
+		constexpr reference(const reference&) noexcept = default;
+
+		constexpr operator bool() const noexcept
+		{
+			return (*_word & _mask) != 0;
+		}
+
+		constexpr const reference& operator=(bool value) const noexcept
+		{
+			if (value)
+			{
+				*_word |= _mask;
+			}
+			else
+			{
+				*_word &= ~_mask;
+			}
+			return *this;
+		}
+
+		constexpr const reference& operator=(const reference& other) const noexcept
+		{
+			return *this = static_cast<bool>(other);
+		}
+
+		constexpr bool operator~() const noexcept
+		{
+			return !static_cast<bool>(*this);
+		}
+
+		constexpr void flip() const noexcept
+		{
+			*_word ^= _mask;
+		}
+
+		constexpr friend void swap(reference a, reference b) noexcept
+		{
+			const bool value = a;
+			a = static_cast<bool>(b);
+			b = value;
+		}
+
+	private:
+		friend class static_bitvector;
+
+		constexpr reference(word_type* word, word_type mask) noexcept
+			: _word(word), _mask(mask)
+		{
+		}
+
+		word_type* _word;
+		word_type _mask;
+	};
+
+	using const_reference = bool;
+
+private:
+
+	using size_field_type = static_vector_detail::size_type_for<Capacity>;
+
+	template <bool Const>
+	struct basic_iterator
+	{
+		using vector_type = std::conditional_t<Const, const static_bitvector, static_bitvector>;
+
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using iterator_concept = std::random_access_iterator_tag;
+		using difference_type = std::ptrdiff_t;
+		using value_type = bool;
+		using reference = std::conditional_t<Const, bool, typename static_bitvector::reference>;
+
+		constexpr basic_iterator() noexcept = default;
+
+		template <bool Other_Const> requires (Const && !Other_Const)
+		constexpr basic_iterator(const basic_iterator<Other_Const>& other) noexcept
+			: _vector(other._vector), _index(other._index)
+		{
+		}
+
+		constexpr reference operator*() const noexcept
+		{
+			if constexpr (Const)
+			{
+				return _vector->test(_index);
+			}
+			else
+			{
+				return _vector->bit(_index);
+			}
+		}
+
+		constexpr reference operator[](difference_type offset) const noexcept
+		{
+			return *(*this + offset);
+		}
+
+		constexpr basic_iterator& operator++() noexcept
+		{
+			++_index;
+			return *this;
+		}
+
+		constexpr basic_iterator operator++(int) noexcept
+		{
+			basic_iterator copy = *this;
+			++_index;
+			return copy;
+		}
+
+		constexpr basic_iterator& operator--() noexcept
+		{
+			--_index;
+			return *this;
+		}
+
+		constexpr basic_iterator operator--(int) noexcept
+		{
+			basic_iterator copy = *this;
+			--_index;
+			return copy;
+		}
+
+		constexpr basic_iterator& operator+=(difference_type offset) noexcept
+		{
+			_index = static_cast<std::size_t>(static_cast<difference_type>(_index) + offset);
+			return *this;
+		}
+
+		constexpr basic_iterator& operator-=(difference_type offset) noexcept
+		{
+			return *this += -offset;
+		}
+
+		constexpr friend basic_iterator operator+(basic_iterator it, difference_type offset) noexcept
+		{
+			return it += offset;
+		}
+
+		constexpr friend basic_iterator operator+(difference_type offset, basic_iterator it) noexcept
+		{
+			return it += offset;
+		}
+
+		constexpr friend basic_iterator operator-(basic_iterator it, difference_type offset) noexcept
+		{
+			return it -= offset;
+		}
+
+		constexpr friend difference_type operator-(const basic_iterator& a, const basic_iterator& b) noexcept
+		{
+			return static_cast<difference_type>(a._index) - static_cast<difference_type>(b._index);
+		}
+
+		constexpr friend bool operator==(const basic_iterator& a, const basic_iterator& b) noexcept
+		{
+			return a._index == b._index;
+		}
+
+		constexpr friend auto operator<=>(const basic_iterator& a, const basic_iterator& b) noexcept
+		{
+			return a._index <=> b._index;
+		}
+
+	private:
+		friend class static_bitvector;
+		friend struct basic_iterator<true>;
+
+		constexpr basic_iterator(vector_type* vector, std::size_t index) noexcept
+			: _vector(vector), _index(index)
+		{
+		}
+
+		vector_type* _vector = nullptr;
+		std::size_t _index = 0;
+	};
+
+public:
+
+	using value_type = bool;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using iterator = basic_iterator<false>;
+	using const_iterator = basic_iterator<true>;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	constexpr static_bitvector() noexcept = default;
+
+	constexpr explicit static_bitvector(std::size_t count, bool value = false) noexcept (Policy::is_nothrow)
+	{
+		resize(count, value);
+	}
+
+	constexpr static_bitvector(std::initializer_list<bool> values) noexcept (Policy::is_nothrow)
+	{
+		if (values.size() > Capacity) [[unlikely]]
+		{
+			Policy::capacity_exceeded("Static bit vector lacks the capacity for so many bits!");
+		}
+
+		for (const bool value : values | std::views::take(Capacity))
+		{
+			unchecked_push_back(value);
+		}
+	}
+
+	constexpr std::size_t size() const noexcept
+	{
+		return _size;
+	}
+
+	constexpr bool empty() const noexcept
+	{
+		return _size == 0;
+	}
+
+	consteval std::size_t max_size() const noexcept
+	{
+		return Capacity;
+	}
+
+	consteval std::size_t capacity() const noexcept
+	{
+		return Capacity;
+	}
+
+	constexpr std::size_t free_space() const noexcept
+	{
+		return Capacity - _size;
+	}
+
+	// The packed words holding the first size() bits, bit i being bit i % 64 of word i / 64. Bits past size() are zero.
+	constexpr std::span<const word_type> words() const noexcept
+	{
+		return std::span<const word_type>(_words.data(), live_words());
+	}
+
+	constexpr iterator begin() noexcept
+	{
+		return iterator(this, 0);
+	}
+
+	constexpr const_iterator begin() const noexcept
+	{
+		return const_iterator(this, 0);
+	}
+
+	constexpr iterator end() noexcept
+	{
+		return iterator(this, _size);
+	}
+
+	constexpr const_iterator end() const noexcept
+	{
+		return const_iterator(this, _size);
+	}
+
+	constexpr const_iterator cbegin() const noexcept
+	{
+		return begin();
+	}
+
+	constexpr const_iterator cend() const noexcept
+	{
+		return end();
+	}
+
+	constexpr reverse_iterator rbegin() noexcept
+	{
+		return reverse_iterator(end());
+	}
+
+	constexpr const_reverse_iterator rbegin() const noexcept
+	{
+		return const_reverse_iterator(end());
+	}
+
+	constexpr reverse_iterator rend() noexcept
+	{
+		return reverse_iterator(begin());
+	}
+
+	constexpr const_reverse_iterator rend() const noexcept
+	{
+		return const_reverse_iterator(begin());
+	}
+
+	constexpr reference operator[](std::size_t index) noexcept (!Policy::checks_indexing || Policy::is_nothrow)
+	{
+		if constexpr (Policy::checks_indexing)
+		{
+			if (index >= _size) [[unlikely]]
+			{
+				Policy::out_of_range("Index out of bounds!");
+			}
+		}
+		return bit(index);
+	}
+
+	constexpr bool operator[](std::size_t index) const noexcept (!Policy::checks_indexing || Policy::is_nothrow)
+	{
+		if constexpr (Policy::checks_indexing)
+		{
+			if (index >= _size) [[unlikely]]
+			{
+				Policy::out_of_range("Index out of bounds!");
+			}
+		}
+		return test(index);
+	}
+
+	constexpr reference at(std::size_t index) noexcept (Policy::is_nothrow)
+	{
+		if (index >= _size) [[unlikely]]
+		{
+			Policy::out_of_range("Index out of bounds!");
+		}
+		return bit(index);
+	}
+
+	constexpr bool at(std::size_t index) const noexcept (Policy::is_nothrow)
+	{
+		if (index >= _size) [[unlikely]]
+		{
+			Policy::out_of_range("Index out of bounds!");
+		}
+		return test(index);
+	}
+
+	constexpr reference front() noexcept
+	{
+		return bit(0);
+	}
+
+	constexpr bool front() const noexcept
+	{
+		return test(0);
+	}
+
+	constexpr reference back() noexcept
+	{
+		return bit(_size - 1u);
+	}
+
+	constexpr bool back() const noexcept
+	{
+		return test(_size - 1u);
+	}
+
+	// Unchecked single bit access, index must be below size().
+	constexpr bool test(std::size_t index) const noexcept
+	{
+		return (_words[index / bits_per_word] & mask_of(index)) != 0;
+	}
+
+	constexpr void set(std::size_t index, bool value = true) noexcept
+	{
+		bit(index) = value;
+	}
+
+	constexpr void reset(std::size_t index) noexcept
+	{
+		_words[index / bits_per_word] &= ~mask_of(index);
+	}
+
+	constexpr void flip(std::size_t index) noexcept
+	{
+		_words[index / bits_per_word] ^= mask_of(index);
+	}
+
+	// Whole vector versions, all of them only touch the first size() bits.
+	constexpr void set() noexcept
+	{
+		std::fill_n(_words.begin(), live_words(), ~word_type{ 0 });
+		clear_tail();
+	}
+
+	constexpr void reset() noexcept
+	{
+		std::fill_n(_words.begin(), live_words(), word_type{ 0 });
+	}
+
+	constexpr void flip() noexcept
+	{
+		for (std::size_t word = 0; word < live_words(); ++word)
+		{
+			_words[word] = ~_words[word];
+		}
+		clear_tail();
+	}
+
+	// The number of set bits.
+	constexpr std::size_t count() const noexcept
+	{
+		std::size_t total = 0;
+		for (std::size_t word = 0; word < live_words(); ++word)
+		{
+			total += static_cast<std::size_t>(std::popcount(_words[word]));
+		}
+		return total;
+	}
+
+	constexpr bool any() const noexcept
+	{
+		return find_first() != npos;
+	}
+
+	constexpr bool none() const noexcept
+	{
+		return !any();
+	}
+
+	constexpr bool all() const noexcept
+	{
+		return count() == _size;
+	}
+
+	// The index of the first set bit, or npos.
+	constexpr std::size_t find_first() const noexcept
+	{
+		return find_from(0, ~word_type{ 0 });
+	}
+
+	// The index of the first set bit after position, or npos.
+	constexpr std::size_t find_next(std::size_t position) const noexcept
+	{
+		if (position + 1 >= _size)
+		{
+			return npos;
+		}
+
+		const std::size_t start = position + 1;
+		return find_from(start / bits_per_word, ~word_type{ 0 } << (start % bits_per_word));
+	}
+
+	constexpr void push_back(bool value) noexcept (Policy::is_nothrow)
+	{
+		if (_size == Capacity) [[unlikely]]
+		{
+			Policy::capacity_exceeded("Bit vector is at full capacity, push back not allowed!");
+			return;
+		}
+
+		unchecked_push_back(value);
+	}
+
+	// Returns false instead of reporting an overflow.
+	constexpr bool try_push_back(bool value) noexcept
+	{
+		if (_size == Capacity)
+		{
+			return false;
+		}
+
+		unchecked_push_back(value);
+		return true;
+	}
+
+	// Appends a bit without checking the capacity, the caller must make sure that size() < capacity().
+	constexpr void unchecked_push_back(bool value) noexcept
+	{
+		static_vector_detail::debug_check(_size < Capacity, "unchecked_push_back on a full static_bitvector");
+
+		// The bit is zero already, see clear_tail.
+		_words[_size / bits_per_word] |= static_cast<word_type>(value) << (_size % bits_per_word);
+		_size++;
+	}
+
+	constexpr void pop_back() noexcept (Policy::is_nothrow)
+	{
+		if (empty()) [[unlikely]]
+		{
+			Policy::out_of_range("Can't pop from empty vector!");
+		}
+
+		truncate(_size - 1u);
+	}
+
+	constexpr void pop_back(std::size_t count) noexcept (Policy::is_nothrow)
+	{
+		if (count > _size) [[unlikely]]
+		{
+			Policy::out_of_range("Can't pop more elements than the vector holds!");
+		}
+
+		truncate(_size - count);
+	}
+
+	// Shrinks the vector to its first count bits, does nothing if it isn't larger than that.
+	constexpr void truncate(std::size_t count) noexcept
+	{
+		if (count < _size)
+		{
+			const std::size_t old_words = live_words();
+			_size = static_cast<size_field_type>(count);
+			std::fill(_words.begin() + static_cast<std::ptrdiff_t>(live_words()), _words.begin() + static_cast<std::ptrdiff_t>(old_words), word_type{ 0 });
+			clear_tail();
+		}
+	}
+
+	constexpr void resize(std::size_t new_size, bool value = false) noexcept (Policy::is_nothrow)
+	{
+		if (new_size > Capacity) [[unlikely]]
+		{
+			Policy::capacity_exceeded("Can't resize beyond capacity!");
+			new_size = Capacity;
+		}
+
+		if (new_size <= _size)
+		{
+			truncate(new_size);
+			return;
+		}
+
+		const std::size_t old_size = _size;
+		_size = static_cast<size_field_type>(new_size);
+
+		if (value)
+		{
+			// The partial word the old bits end in, then whole words, then the tail.
+			const std::size_t first_word = old_size / bits_per_word;
+			_words[first_word] |= ~word_type{ 0 } << (old_size % bits_per_word);
+			std::fill(_words.begin() + static_cast<std::ptrdiff_t>(first_word + 1), _words.begin() + static_cast<std::ptrdiff_t>(live_words()), ~word_type{ 0 });
+			clear_tail();
+		}
+	}
+
+	constexpr void clear() noexcept
+	{
+		reset();
+		_size = 0;
+	}
+
+	// Bitwise operations a word at a time. Only the first size() bits of *this change, bits of other past its size count as zero.
+	constexpr static_bitvector& operator&=(const static_bitvector& other) noexcept
+	{
+		for (std::size_t word = 0; word < live_words(); ++word)
+		{
+			_words[word] &= other._words[word];
+		}
+		return *this;
+	}
+
+	constexpr static_bitvector& operator|=(const static_bitvector& other) noexcept
+	{
+		for (std::size_t word = 0; word < live_words(); ++word)
+		{
+			_words[word] |= other._words[word];
+		}
+		clear_tail();
+		return *this;
+	}
+
+	constexpr static_bitvector& operator^=(const static_bitvector& other) noexcept
+	{
+		for (std::size_t word = 0; word < live_words(); ++word)
+		{
+			_words[word] ^= other._words[word];
+		}
+		clear_tail();
+		return *this;
+	}
+
+	// Clears the bits of *this that are set in other.
+	constexpr static_bitvector& subtract(const static_bitvector& other) noexcept
+	{
+		for (std::size_t word = 0; word < live_words(); ++word)
+		{
+			_words[word] &= ~other._words[word];
+		}
+		return *this;
+	}
+
+	constexpr friend static_bitvector operator&(static_bitvector lhs, const static_bitvector& rhs) noexcept
+	{
+		return lhs &= rhs;
+	}
+
+	constexpr friend static_bitvector operator|(static_bitvector lhs, const static_bitvector& rhs) noexcept
+	{
+		return lhs |= rhs;
+	}
+
+	constexpr friend static_bitvector operator^(static_bitvector lhs, const static_bitvector& rhs) noexcept
+	{
+		return lhs ^= rhs;
+	}
+
+	constexpr friend static_bitvector operator~(static_bitvector vector) noexcept
+	{
+		vector.flip();
+		return vector;
+	}
+
+	// With the bits past size() zero, equal vectors have equal words.
+	constexpr friend bool operator==(const static_bitvector& lhs, const static_bitvector& rhs) noexcept
+	{
+		return lhs._size == rhs._size && std::equal(lhs._words.begin(), lhs._words.begin() + static_cast<std::ptrdiff_t>(lhs.live_words()), rhs._words.begin());
+	}
+
+private:
+
+	static constexpr word_type mask_of(std::size_t index) noexcept
+	{
+		return word_type{ 1 } << (index % bits_per_word);
+	}
+
+	constexpr reference bit(std::size_t index) noexcept
+	{
+		return reference(&_words[index / bits_per_word], mask_of(index));
+	}
+
+	constexpr const_reference bit(std::size_t index) const noexcept
+	{
+		return test(index);
+	}
+
+	constexpr std::size_t live_words() const noexcept
+	{
+		return (_size + bits_per_word - 1) / bits_per_word;
+	}
+
+	// Zeroes the bits of the last live word past size(), restoring the invariant the word-wise operations rely on.
+	constexpr void clear_tail() noexcept
+	{
+		if (_size % bits_per_word != 0)
+		{
+			_words[_size / bits_per_word] &= ~(~word_type{ 0 } << (_size % bits_per_word));
+		}
+	}
+
+	// The first set bit in word first_word masked by first_mask, or in the live words after it.
+	constexpr std::size_t find_from(std::size_t first_word, word_type first_mask) const noexcept
+	{
+		const std::size_t end = live_words();
+		if (first_word >= end)
+		{
+			return npos;
+		}
+
+		word_type word = _words[first_word] & first_mask;
+		for (std::size_t index = first_word;;)
+		{
+			if (word != 0)
+			{
+				return index * bits_per_word + static_cast<std::size_t>(std::countr_zero(word));
+			}
+
+			if (++index == end)
+			{
+				return npos;
+			}
+			word = _words[index];
+		}
+	}
+
+	std::array<word_type, word_count> _words{};
+	size_field_type _size = 0;
+};
+
+namespace static_bitvector_static_assertions
+{
+	// 1024 flags in 128 bytes, plus the size.
+	static_assert(sizeof(static_bitvector<1024>) == 128 + sizeof(std::uint64_t));
+	static_assert(std::is_trivially_copyable_v<static_bitvector<1024>>);
+	static_assert(std::random_access_iterator<static_bitvector<64>::const_iterator>);
+
+	static_assert([]
+	{
+		static_bitvector<130> bits(130);
+		bits[3] = true;
+		bits[64] = true;
+		bits[129] = true;
+		return bits.count() == 3 && bits.find_first() == 3 && bits.find_next(3) == 64 && bits.find_next(64) == 129 && bits.find_next(129) == bits.npos;
+	}());
+
+	static_assert([]
+	{
+		static_bitvector<100> a(70, true);
+		static_bitvector<100> b{ true, false, true };
+		return (a & b).count() == 2 && (a | b).count() == 70 && (a ^ b).count() == 68 && (~a).none() && (~b).count() == 1;
+	}());
+
+	static_assert([]
+	{
+		static_bitvector<200> bits(150, true);
+		bits.truncate(65);
+		bits.resize(130);
+		return bits.count() == 65 && !bits.all() && bits.words().size() == 3;
+	}());
+}
@@ -0,0 +1,254 @@
+#pragma once
+
+#include "static_vector.hpp"
+
+#include <cstdlib>
+#include <memory_resource>
+
+// A std::pmr::memory_resource handing out memory from an inline buffer of Bytes bytes, owned the way static_vector owns its elements,
+// so std::pmr containers can run on the stack or inside another object without touching the global heap.
+//
+// By default it is a bump allocator: deallocation only gives memory back when it frees the most recent allocation (which covers
+// a container growing into its last reallocation), and release() rewinds the whole buffer. With Size_Classes, requests of up to
+// max_class_bytes are rounded up to a power of two and freed blocks are kept on one intrusive free list per size, so node based
+// containers that keep inserting and erasing reuse their memory instead of exhausting the buffer.
+//
+// Once the buffer is exhausted, requests go to the upstream resource if one was given. Without one the exhaustion is reported to
+// Policy::capacity_exceeded, and should it return, std::bad_alloc is thrown (or the program aborts when built without exceptions).
+// The default policy does return, so running out throws std::bad_alloc like it does for any other memory resource.
+// peak_bytes() tells how much of the buffer a workload needed, for sizing Bytes.
+//
+// Like std::pmr::monotonic_buffer_resource, it is not thread safe.
+template <std::size_t Bytes, bool Size_Classes = false, typename Policy = static_vector_saturate_policy>
+class static_buffer_resource final : public std::pmr::memory_resource
+{
+	static_assert(Bytes > 0, "static_buffer_resource needs a buffer of at least one byte");
+
+	static constexpr std::size_t block_alignment = alignof(std::max_align_t);
+	static constexpr std::size_t min_class_bytes = std::max<std::size_t>(2 * sizeof(void*), block_alignment);
+
+public:
+
+	// Larger requests, or more strictly aligned ones, are bump allocated even with Size_Classes.
+	static constexpr std::size_t max_class_bytes = 2048;
+
+	explicit static_buffer_resource(std::pmr::memory_resource* upstream = nullptr) noexcept
+		: _upstream(upstream)
+	{
+	}
+
+	// Containers hold on to the resource by address.
+	static_buffer_resource(const static_buffer_resource&) = delete;
+	static_buffer_resource& operator=(const static_buffer_resource&) = delete;
+
+	static consteval std::size_t capacity() noexcept
+	{
+		return Bytes;
+	}
+
+	std::pmr::memory_resource* upstream_resource() const noexcept
+	{
+		return _upstream;
+	}
+
+	// How far into the buffer allocations currently reach.
+	std::size_t bytes_used() const noexcept
+	{
+		return _top;
+	}
+
+	// The most bytes_used() has ever been since construction or the last release().
+	std::size_t peak_bytes() const noexcept
+	{
+		return _peak;
+	}
+
+	// Bytes of the buffer handed out and not yet deallocated, counting the rounding to size classes.
+	std::size_t bytes_in_use() const noexcept
+	{
+		return _in_use;
+	}
+
+	// Bytes currently allocated from upstream, and how many allocations went there in total.
+	std::size_t upstream_bytes() const noexcept
+	{
+		return _upstream_bytes;
+	}
+
+	std::size_t upstream_allocations() const noexcept
+	{
+		return _upstream_allocations;
+	}
+
+	bool owns(const void* pointer) const noexcept
+	{
+		const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(pointer);
+		const std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(_buffer);
+		return address >= begin && address < begin + Bytes;
+	}
+
+	// Rewinds the buffer, everything allocated from it must be dead by now. Upstream allocations are left alone,
+	// their owners deallocate them through this resource as usual.
+	void release() noexcept
+	{
+		_top = 0;
+		_peak = 0;
+		_in_use = 0;
+		if constexpr (Size_Classes)
+		{
+			_free_lists.fill(nullptr);
+		}
+	}
+
+protected:
+
+	void* do_allocate(std::size_t bytes, std::size_t alignment) override
+	{
+		bytes = std::max<std::size_t>(bytes, 1);
+
+		if constexpr (Size_Classes)
+		{
+			if (fits_size_class(bytes, alignment))
+			{
+				const std::size_t size_class = class_of(bytes);
+				const std::size_t class_bytes = min_class_bytes << size_class;
+
+				if (free_block* const block = _free_lists[size_class])
+				{
+					_free_lists[size_class] = block->next;
+					_in_use += class_bytes;
+					return block;
+				}
+
+				if (void* const memory = bump(class_bytes, block_alignment))
+				{
+					_in_use += class_bytes;
+					return memory;
+				}
+
+				return allocate_upstream(bytes, alignment);
+			}
+		}
+
+		if (void* const memory = bump(bytes, alignment))
+		{
+			_in_use += bytes;
+			return memory;
+		}
+
+		return allocate_upstream(bytes, alignment);
+	}
+
+	void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override
+	{
+		bytes = std::max<std::size_t>(bytes, 1);
+
+		if (!owns(pointer))
+		{
+			_upstream->deallocate(pointer, bytes, alignment);
+			_upstream_bytes -= bytes;
+			return;
+		}
+
+		if constexpr (Size_Classes)
+		{
+			if (fits_size_class(bytes, alignment))
+			{
+				const std::size_t size_class = class_of(bytes);
+				_free_lists[size_class] = ::new (pointer) free_block{ _free_lists[size_class] };
+				_in_use -= min_class_bytes << size_class;
+				return;
+			}
+		}
+
+		_in_use -= bytes;
+
+		// Bump allocation can only take back the most recent block.
+		const std::size_t offset = static_cast<std::size_t>(static_cast<std::byte*>(pointer) - _buffer);
+		if (offset + bytes == _top)
+		{
+			_top = offset;
+		}
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+	{
+		return this == &other;
+	}
+
+private:
+
+	// What a freed block of a size class holds while it waits on its free list.
+	struct free_block
+	{
+		free_block* next;
+	};
+
+	// Size classes run from min_class_bytes to max_class_bytes in powers of two.
+	static constexpr std::size_t class_count = static_cast<std::size_t>(std::countr_zero(max_class_bytes / min_class_bytes)) + 1;
+
+	struct no_free_lists
+	{
+	};
+
+	static constexpr bool fits_size_class(std::size_t bytes, std::size_t alignment) noexcept
+	{
+		return bytes <= max_class_bytes && alignment <= block_alignment;
+	}
+
+	static constexpr std::size_t class_of(std::size_t bytes) noexcept
+	{
+		return static_cast<std::size_t>(std::countr_zero(std::bit_ceil(std::max(bytes, min_class_bytes)) / min_class_bytes));
+	}
+
+	void* bump(std::size_t bytes, std::size_t alignment) noexcept
+	{
+		const std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(_buffer);
+		const std::size_t start = static_vector_detail::round_up(begin + _top, alignment) - begin;
+
+		if (start > Bytes || Bytes - start < bytes)
+		{
+			return nullptr;
+		}
+
+		_top = start + bytes;
+		_peak = std::max(_peak, _top);
+
+		return _buffer + start;
+	}
+
+	void* allocate_upstream(std::size_t bytes, std::size_t alignment)
+	{
+		if (_upstream == nullptr) [[unlikely]]
+		{
+			Policy::capacity_exceeded("Static buffer resource is exhausted!");
+#if STATIC_VECTOR_HAS_EXCEPTIONS
+			throw std::bad_alloc();
+#else
+			std::abort();
+#endif
+		}
+
+		void* const memory = _upstream->allocate(bytes, alignment);
+		_upstream_bytes += bytes;
+		_upstream_allocations++;
+
+		return memory;
+	}
+
+	alignas(std::max_align_t) std::byte _buffer[Bytes];
+	std::size_t _top = 0;
+	std::size_t _peak = 0;
+	std::size_t _in_use = 0;
+	std::size_t _upstream_bytes = 0;
+	std::size_t _upstream_allocations = 0;
+	std::pmr::memory_resource* _upstream;
+	[[no_unique_address]] std::conditional_t<Size_Classes, std::array<free_block*, class_count>, no_free_lists> _free_lists{};
+};
+
+namespace static_buffer_resource_static_assertions
+{
+	// The buffer, the bookkeeping and the vtable pointer; the free lists only when asked for.
+	static_assert(sizeof(static_buffer_resource<1024, true>) > sizeof(static_buffer_resource<1024>));
+	static_assert(sizeof(static_buffer_resource<1024>) <= 1024 + 8 * sizeof(std::max_align_t));
+}
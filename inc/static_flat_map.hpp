@@ -0,0 +1,718 @@
+#pragma once
+
+#include "static_flat_set.hpp"
+
+// A sorted map of unique keys over two static_vectors, one for the keys and one for the values: no allocation, and a lookup only
+// touches the keys, which are packed together instead of being interleaved with the values. Single inserts and erases are O(n),
+// insert(sorted_range, pairs) merges a whole batch in O(n + m). See flat_layout for the search layouts.
+// Iterators dereference to a std::pair<const Key&, Value&> proxy, like std::flat_map's.
+template <typename Key, typename Value, std::size_t Capacity, typename Compare = std::less<Key>, flat_layout Layout = flat_layout::sorted, typename Policy = static_vector_default_policy>
+class static_flat_map
+{
+	using key_storage_type = static_vector<Key, Capacity, Policy>;
+	using value_storage_type = static_vector<Value, Capacity, Policy>;
+
+	template <bool Const>
+	struct basic_iterator
+	{
+		using map_type = std::conditional_t<Const, const static_flat_map, static_flat_map>;
+
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using iterator_concept = std::random_access_iterator_tag;
+		using difference_type = std::ptrdiff_t;
+		using value_type = std::pair<Key, Value>;
+		using reference = std::pair<const Key&, std::conditional_t<Const, const Value&, Value&>>;
+
+		// operator-> has to hand out a pointer, so it points into a copy of the reference pair.
+		struct pointer
+		{
+			reference pair;
+
+			constexpr const reference* operator->() const noexcept
+			{
+				return std::addressof(pair);
+			}
+		};
+
+		constexpr basic_iterator() noexcept = default;
+
+		template <bool Other_Const> requires (Const && !Other_Const)
+		constexpr basic_iterator(const basic_iterator<Other_Const>& other) noexcept
+			: _map(other._map), _index(other._index)
+		{
+		}
+
+		constexpr reference operator*() const noexcept
+		{
+			return reference(_map->_keys[_index], _map->_values[_index]);
+		}
+
+		constexpr pointer operator->() const noexcept
+		{
+			return pointer{ **this };
+		}
+
+		constexpr reference operator[](difference_type offset) const noexcept
+		{
+			return *(*this + offset);
+		}
+
+		constexpr basic_iterator& operator++() noexcept
+		{
+			++_index;
+			return *this;
+		}
+
+		constexpr basic_iterator operator++(int) noexcept
+		{
+			basic_iterator copy = *this;
+			++_index;
+			return copy;
+		}
+
+		constexpr basic_iterator& operator--() noexcept
+		{
+			--_index;
+			return *this;
+		}
+
+		constexpr basic_iterator operator--(int) noexcept
+		{
+			basic_iterator copy = *this;
+			--_index;
+			return copy;
+		}
+
+		constexpr basic_iterator& operator+=(difference_type offset) noexcept
+		{
+			_index = static_cast<std::size_t>(static_cast<difference_type>(_index) + offset);
+			return *this;
+		}
+
+		constexpr basic_iterator& operator-=(difference_type offset) noexcept
+		{
+			return *this += -offset;
+		}
+
+		constexpr friend basic_iterator operator+(basic_iterator it, difference_type offset) noexcept
+		{
+			return it += offset;
+		}
+
+		constexpr friend basic_iterator operator+(difference_type offset, basic_iterator it) noexcept
+		{
+			return it += offset;
+		}
+
+		constexpr friend basic_iterator operator-(basic_iterator it, difference_type offset) noexcept
+		{
+			return it -= offset;
+		}
+
+		constexpr friend difference_type operator-(const basic_iterator& a, const basic_iterator& b) noexcept
+		{
+			return static_cast<difference_type>(a._index) - static_cast<difference_type>(b._index);
+		}
+
+		constexpr friend bool operator==(const basic_iterator& a, const basic_iterator& b) noexcept
+		{
+			return a._index == b._index;
+		}
+
+		constexpr friend auto operator<=>(const basic_iterator& a, const basic_iterator& b) noexcept
+		{
+			return a._index <=> b._index;
+		}
+
+	private:
+		friend class static_flat_map;
+		friend struct basic_iterator<true>;
+
+		constexpr basic_iterator(map_type* map, std::size_t index) noexcept
+			: _map(map), _index(index)
+		{
+		}
+
+		map_type* _map = nullptr;
+		std::size_t _index = 0;
+	};
+
+public:
+
+	using key_type = Key;
+	using mapped_type = Value;
+	using value_type = std::pair<Key, Value>;
+	using key_compare = Compare;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = std::pair<const Key&, Value&>;
+	using const_reference = std::pair<const Key&, const Value&>;
+	using iterator = basic_iterator<false>;
+	using const_iterator = basic_iterator<true>;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	constexpr static_flat_map() noexcept (std::is_nothrow_default_constructible_v<Compare>) = default;
+
+	constexpr explicit static_flat_map(const Compare& compare)
+		: _compare(compare)
+	{
+	}
+
+	constexpr static_flat_map(std::initializer_list<value_type> pairs, const Compare& compare = Compare())
+		: _compare(compare)
+	{
+		insert(pairs.begin(), pairs.end());
+	}
+
+	template <typename Iterator> requires (std::input_iterator<Iterator>)
+	constexpr static_flat_map(Iterator first, Iterator last, const Compare& compare = Compare())
+		: _compare(compare)
+	{
+		insert(first, last);
+	}
+
+	template <std::ranges::input_range Range>
+	constexpr static_flat_map(sorted_range_t, Range&& pairs, const Compare& compare = Compare())
+		: _compare(compare)
+	{
+		insert(sorted_range, std::forward<Range>(pairs));
+	}
+
+	constexpr iterator begin() noexcept
+	{
+		return iterator(this, 0);
+	}
+
+	constexpr const_iterator begin() const noexcept
+	{
+		return const_iterator(this, 0);
+	}
+
+	constexpr iterator end() noexcept
+	{
+		return iterator(this, size());
+	}
+
+	constexpr const_iterator end() const noexcept
+	{
+		return const_iterator(this, size());
+	}
+
+	constexpr const_iterator cbegin() const noexcept
+	{
+		return begin();
+	}
+
+	constexpr const_iterator cend() const noexcept
+	{
+		return end();
+	}
+
+	constexpr reverse_iterator rbegin() noexcept
+	{
+		return reverse_iterator(end());
+	}
+
+	constexpr const_reverse_iterator rbegin() const noexcept
+	{
+		return const_reverse_iterator(end());
+	}
+
+	constexpr reverse_iterator rend() noexcept
+	{
+		return reverse_iterator(begin());
+	}
+
+	constexpr const_reverse_iterator rend() const noexcept
+	{
+		return const_reverse_iterator(begin());
+	}
+
+	constexpr std::size_t size() const noexcept
+	{
+		return _keys.size();
+	}
+
+	constexpr bool empty() const noexcept
+	{
+		return _keys.empty();
+	}
+
+	static consteval std::size_t capacity() noexcept
+	{
+		return Capacity;
+	}
+
+	static consteval std::size_t max_size() noexcept
+	{
+		return Capacity;
+	}
+
+	// The keys in ascending order, contiguous.
+	constexpr std::span<const Key> keys() const noexcept
+	{
+		return std::span<const Key>(_keys.data(), _keys.size());
+	}
+
+	// The values in the order of their keys, contiguous.
+	constexpr std::span<Value> values() noexcept
+	{
+		return std::span<Value>(_values.data(), _values.size());
+	}
+
+	constexpr std::span<const Value> values() const noexcept
+	{
+		return std::span<const Value>(_values.data(), _values.size());
+	}
+
+	constexpr key_compare key_comp() const
+	{
+		return _compare;
+	}
+
+	constexpr iterator lower_bound(const Key& key)
+	{
+		return iterator(this, lower_bound_index(key));
+	}
+
+	constexpr const_iterator lower_bound(const Key& key) const
+	{
+		return const_iterator(this, lower_bound_index(key));
+	}
+
+	template <typename K> requires (static_flat_detail::transparent<Compare>)
+	constexpr iterator lower_bound(const K& key)
+	{
+		return iterator(this, lower_bound_index(key));
+	}
+
+	template <typename K> requires (static_flat_detail::transparent<Compare>)
+	constexpr const_iterator lower_bound(const K& key) const
+	{
+		return const_iterator(this, lower_bound_index(key));
+	}
+
+	constexpr iterator upper_bound(const Key& key)
+	{
+		return iterator(this, upper_bound_index(key));
+	}
+
+	constexpr const_iterator upper_bound(const Key& key) const
+	{
+		return const_iterator(this, upper_bound_index(key));
+	}
+
+	template <typename K> requires (static_flat_detail::transparent<Compare>)
+	constexpr iterator upper_bound(const K& key)
+	{
+		return iterator(this, upper_bound_index(key));
+	}
+
+	template <typename K> requires (static_flat_detail::transparent<Compare>)
+	constexpr const_iterator upper_bound(const K& key) const
+	{
+		return const_iterator(this, upper_bound_index(key));
+	}
+
+	constexpr iterator find(const Key& key)
+	{
+		return iterator(this, find_index(key));
+	}
+
+	constexpr const_iterator find(const Key& key) const
+	{
+		return const_iterator(this, find_index(key));
+	}
+
+	template <typename K> requires (static_flat_detail::transparent<Compare>)
+	constexpr iterator find(const K& key)
+	{
+		return iterator(this, find_index(key));
+	}
+
+	template <typename K> requires (static_flat_detail::transparent<Compare>)
+	constexpr const_iterator find(const K& key) const
+	{
+		return const_iterator(this, find_index(key));
+	}
+
+	constexpr bool contains(const Key& key) const
+	{
+		return find_index(key) != size();
+	}
+
+	template <typename K> requires (static_flat_detail::transparent<Compare>)
+	constexpr bool contains(const K& key) const
+	{
+		return find_index(key) != size();
+	}
+
+	constexpr std::size_t count(const Key& key) const
+	{
+		return contains(key) ? 1 : 0;
+	}
+
+	template <typename K> requires (static_flat_detail::transparent<Compare>)
+	constexpr std::size_t count(const K& key) const
+	{
+		return contains(key) ? 1 : 0;
+	}
+
+	// The value for key, or nullptr. Saves building an iterator on the lookup paths that just want the value.
+	constexpr Value* find_value(const Key& key)
+	{
+		const std::size_t index = find_index(key);
+		return index != size() ? std::addressof(_values[index]) : nullptr;
+	}
+
+	constexpr const Value* find_value(const Key& key) const
+	{
+		const std::size_t index = find_index(key);
+		return index != size() ? std::addressof(_values[index]) : nullptr;
+	}
+
+	constexpr Value& at(const Key& key) noexcept (Policy::is_nothrow)
+	{
+		const std::size_t index = find_index(key);
+		if (index == size()) [[unlikely]]
+		{
+			Policy::out_of_range("Key not found in flat map!");
+		}
+		return _values[index];
+	}
+
+	constexpr const Value& at(const Key& key) const noexcept (Policy::is_nothrow)
+	{
+		const std::size_t index = find_index(key);
+		if (index == size()) [[unlikely]]
+		{
+			Policy::out_of_range("Key not found in flat map!");
+		}
+		return _values[index];
+	}
+
+	// Inserts a value initialized Value if key is missing.
+	constexpr Value& operator[](const Key& key) requires (std::is_default_constructible_v<Value>)
+	{
+		return try_emplace(key).first->second;
+	}
+
+	constexpr Value& operator[](Key&& key) requires (std::is_default_constructible_v<Value>)
+	{
+		return try_emplace(std::move(key)).first->second;
+	}
+
+	// Constructs the value from args if key is missing and leaves args untouched otherwise. When the map is full, the overflow is
+	// reported to Policy, and should it return nothing is inserted and end() comes back with false.
+	template <typename ... Args>
+	constexpr std::pair<iterator, bool> try_emplace(const Key& key, Args&& ... args)
+	{
+		return insert_unique(key, std::forward<Args>(args)...);
+	}
+
+	template <typename ... Args>
+	constexpr std::pair<iterator, bool> try_emplace(Key&& key, Args&& ... args)
+	{
+		return insert_unique(std::move(key), std::forward<Args>(args)...);
+	}
+
+	constexpr std::pair<iterator, bool> insert(const value_type& pair)
+	{
+		return insert_unique(pair.first, pair.second);
+	}
+
+	constexpr std::pair<iterator, bool> insert(value_type&& pair)
+	{
+		return insert_unique(std::move(pair.first), std::move(pair.second));
+	}
+
+	template <typename K, typename V>
+	constexpr std::pair<iterator, bool> emplace(K&& key, V&& value)
+	{
+		if constexpr (std::is_same_v<std::remove_cvref_t<K>, Key>)
+		{
+			return insert_unique(std::forward<K>(key), std::forward<V>(value));
+		}
+		else
+		{
+			return insert_unique(Key(std::forward<K>(key)), std::forward<V>(value));
+		}
+	}
+
+	template <typename V> requires (std::is_assignable_v<Value&, V>)
+	constexpr std::pair<iterator, bool> insert_or_assign(const Key& key, V&& value)
+	{
+		return assign_or_insert(key, std::forward<V>(value));
+	}
+
+	template <typename V> requires (std::is_assignable_v<Value&, V>)
+	constexpr std::pair<iterator, bool> insert_or_assign(Key&& key, V&& value)
+	{
+		return assign_or_insert(std::move(key), std::forward<V>(value));
+	}
+
+	// Inserts the pairs one at a time, prefer insert(sorted_range, ...) for input that is already sorted.
+	template <typename Iterator> requires (std::input_iterator<Iterator>)
+	constexpr void insert(Iterator first, Iterator last)
+	{
+		for (; first != last; ++first)
+		{
+			const auto& [key, value] = *first;
+			insert_unique(key, value);
+		}
+	}
+
+	constexpr void insert(std::initializer_list<value_type> pairs)
+	{
+		insert(pairs.begin(), pairs.end());
+	}
+
+	// Merges a range of key/value pairs sorted by key: the new pairs are appended in one pass and then merged with the existing ones
+	// in place, O(size() + size(pairs)) instead of a shift per pair. Keys already present keep their value. If the new pairs
+	// don't all fit, or one throws while being appended, the map is left unchanged; the overflow is reported to Policy.
+	template <std::ranges::input_range Range>
+	constexpr void insert(sorted_range_t, Range&& pairs)
+	{
+		const std::size_t old_size = size();
+		merge_guard unmerged{ *this, old_size };
+
+		const auto key_of = [](const auto& pair) -> const auto&
+		{
+			return std::get<0>(pair);
+		};
+
+		const bool fits = static_flat_detail::for_each_new_key(keys(), pairs, key_of, _compare, [&](const auto& pair) -> const Key*
+		{
+			if (_keys.size() == Capacity) [[unlikely]]
+			{
+				return nullptr;
+			}
+
+			_values.unchecked_emplace_back(std::get<1>(pair));
+			append_guard guard{ *this };
+
+			return std::addressof(_keys.unchecked_emplace_back(std::get<0>(pair)));
+		});
+
+		if (!fits) [[unlikely]]
+		{
+			Policy::capacity_exceeded("Flat map lacks the capacity for so many pairs!");
+			return;
+		}
+
+		unmerged.appended = true;
+
+		static_flat_detail::merge_runs<Capacity>(_keys.data(), old_size, _keys.size(), _compare, [&](std::size_t a, std::size_t b)
+		{
+			std::ranges::swap(_keys[a], _keys[b]);
+			std::ranges::swap(_values[a], _values[b]);
+		});
+		_index.rebuild(keys());
+	}
+
+	template <typename Iterator> requires (std::input_iterator<Iterator>)
+	constexpr void insert(sorted_range_t, Iterator first, Iterator last)
+	{
+		insert(sorted_range, std::ranges::subrange(first, last));
+	}
+
+	constexpr iterator erase(const_iterator position)
+	{
+		return erase(position, std::next(position));
+	}
+
+	constexpr iterator erase(const_iterator from, const_iterator to)
+	{
+		_keys.erase(_keys.begin() + static_cast<difference_type>(from._index), _keys.begin() + static_cast<difference_type>(to._index));
+		_values.erase(_values.begin() + static_cast<difference_type>(from._index), _values.begin() + static_cast<difference_type>(to._index));
+		_index.rebuild(keys());
+
+		return iterator(this, from._index);
+	}
+
+	constexpr std::size_t erase(const Key& key)
+	{
+		return erase_key(key);
+	}
+
+	template <typename K> requires (static_flat_detail::transparent<Compare> && !std::is_convertible_v<K, const_iterator>)
+	constexpr std::size_t erase(const K& key)
+	{
+		return erase_key(key);
+	}
+
+	constexpr void clear() noexcept
+	{
+		truncate(0);
+	}
+
+	constexpr friend bool operator==(const static_flat_map& lhs, const static_flat_map& rhs) requires (std::equality_comparable<Key> && std::equality_comparable<Value>)
+	{
+		return lhs._keys == rhs._keys && lhs._values == rhs._values;
+	}
+
+private:
+
+	// Drops the value just appended should constructing its key throw, keeping both arrays the same length.
+	struct append_guard
+	{
+		static_flat_map& map;
+
+		constexpr ~append_guard()
+		{
+			if (map._values.size() != map._keys.size())
+			{
+				map._values.pop_back();
+			}
+		}
+	};
+
+	template <typename K>
+	constexpr std::size_t lower_bound_index(const K& key) const
+	{
+		return _index.lower_bound(keys(), key, _compare);
+	}
+
+	// Keys are unique, so the upper bound is the lower bound unless that one holds an equivalent key.
+	template <typename K>
+	constexpr std::size_t upper_bound_index(const K& key) const
+	{
+		const std::size_t index = lower_bound_index(key);
+		return index + static_cast<std::size_t>(index != size() && !_compare(key, _keys[index]));
+	}
+
+	template <typename K>
+	constexpr std::size_t find_index(const K& key) const
+	{
+		const std::size_t index = lower_bound_index(key);
+		return index != size() && !_compare(key, _keys[index]) ? index : size();
+	}
+
+	template <typename K, typename ... Args>
+	constexpr std::pair<iterator, bool> insert_unique(K&& key, Args&& ... args)
+	{
+		const std::size_t index = lower_bound_index(key);
+
+		if (index != size() && !_compare(key, _keys[index]))
+		{
+			return { iterator(this, index), false };
+		}
+
+		if (size() == Capacity) [[unlikely]]
+		{
+			Policy::capacity_exceeded("Flat map is at full capacity, insertion not allowed!");
+			return { end(), false };
+		}
+
+		// The value goes in first, if the key then fails to construct the value is taken out again.
+		_values.emplace(_values.begin() + static_cast<difference_type>(index), std::forward<Args>(args)...);
+		insert_guard guard{ *this, index };
+		_keys.emplace(_keys.begin() + static_cast<difference_type>(index), std::forward<K>(key));
+		guard.inserted = true;
+
+		_index.rebuild(keys());
+
+		return { iterator(this, index), true };
+	}
+
+	// Takes back the pairs appended past old_size by a bulk insertion that didn't get to merge them, so the keys stay sorted.
+	struct merge_guard
+	{
+		static_flat_map& map;
+		std::size_t old_size;
+		bool appended = false;
+
+		constexpr ~merge_guard()
+		{
+			if (!appended)
+			{
+				map.truncate(old_size);
+			}
+		}
+	};
+
+	struct insert_guard
+	{
+		static_flat_map& map;
+		std::size_t index;
+		bool inserted = false;
+
+		constexpr ~insert_guard()
+		{
+			if (!inserted)
+			{
+				map._values.erase(map._values.begin() + static_cast<difference_type>(index));
+			}
+		}
+	};
+
+	template <typename K, typename V>
+	constexpr std::pair<iterator, bool> assign_or_insert(K&& key, V&& value)
+	{
+		const std::size_t index = find_index(key);
+
+		if (index != size())
+		{
+			_values[index] = std::forward<V>(value);
+			return { iterator(this, index), false };
+		}
+
+		return insert_unique(std::forward<K>(key), std::forward<V>(value));
+	}
+
+	template <typename K>
+	constexpr std::size_t erase_key(const K& key)
+	{
+		const std::size_t index = find_index(key);
+		if (index == size())
+		{
+			return 0;
+		}
+
+		erase(const_iterator(this, index));
+		return 1;
+	}
+
+	constexpr void truncate(std::size_t count) noexcept
+	{
+		_keys.truncate(count);
+		_values.truncate(count);
+		_index.rebuild(keys());
+	}
+
+	key_storage_type _keys;
+	value_storage_type _values;
+	[[no_unique_address]] static_flat_detail::search_index<Key, Capacity, Layout> _index;
+	[[no_unique_address]] Compare _compare;
+};
+
+namespace static_flat_map_static_assertions
+{
+	static_assert(std::convertible_to<static_flat_map<int, int, 8>::iterator, static_flat_map<int, int, 8>::const_iterator>);
+
+	// Keys and values live in arrays of their own.
+	static_assert(sizeof(static_flat_map<int, int, 8>) == 2 * sizeof(static_vector<int, 8>));
+
+	// Erasing an empty range leaves every entry in place.
+	constexpr bool erases_nothing()
+	{
+		static_flat_map<std::string, std::string, 4> words{ { "alpha", "a" }, { "beta", "b" }, { "gamma", "c" } };
+		words.erase(words.begin(), words.begin());
+		return words.size() == 3 && words.begin()->first == "alpha" && words.at("gamma") == "c";
+	}
+
+	static_assert(erases_nothing());
+
+	// A bulk insertion that can't append all of its pairs takes back the ones it did, so the keys stay sorted. A key or value
+	// constructor throwing halfway unwinds through the same path, but can't be thrown in a constant expression.
+	constexpr bool unappends_pairs()
+	{
+		static_flat_map<std::string, std::string, 4, std::less<>, flat_layout::sorted, static_vector_saturate_policy> words{ { "beta", "b" }, { "delta", "d" }, { "gamma", "c" } };
+		words.insert(sorted_range, std::array<std::pair<std::string, std::string>, 2>{ { { "alpha", "a" }, { "epsilon", "e" } } });
+		return words.size() == 3 && words.begin()->first == "beta" && words.at("gamma") == "c" && !words.contains("alpha");
+	}
+
+	static_assert(unappends_pairs());
+}
@@ -0,0 +1,582 @@
+#pragma once
+
+#include "static_vector.hpp"
+
+#include <span>
+
+// How static_flat_set and static_flat_map lay their keys out for lookups.
+//  - sorted: only the sorted keys, searched with a branchless binary search.
+//  - eytzinger: additionally keeps a copy of the keys in breadth first (Eytzinger) order, each with its rank among the sorted keys.
+//    A search walks down an implicit tree whose first levels share a handful of cache lines, so the hot top of the tree stays cached
+//    on large read-mostly tables. The price is the copy and an O(size) rebuild after every modification.
+enum class flat_layout
+{
+	sorted,
+	eytzinger
+};
+
+// Tag for the bulk inserts taking a range that is already sorted by the container's comparator (duplicates are allowed and skipped).
+struct sorted_range_t
+{
+	explicit sorted_range_t() = default;
+};
+
+inline constexpr sorted_range_t sorted_range{};
+
+namespace static_flat_detail
+{
+	template <typename Compare>
+	concept transparent = requires { typename Compare::is_transparent; };
+
+	// Index of the first key not ordered before key. The trip count only depends on size, and the comparison merely selects
+	// the next base, which compiles to a conditional move instead of a branch the predictor can't learn.
+	template <typename Key, typename K, typename Compare>
+	constexpr std::size_t lower_bound_index(const Key* keys, std::size_t size, const K& key, const Compare& compare)
+	{
+		if (size == 0)
+		{
+			return 0;
+		}
+
+		const Key* base = keys;
+		while (size > 1)
+		{
+			const std::size_t half = size / 2;
+			base = compare(base[half], key) ? base + half : base;
+			size -= half;
+		}
+
+		return static_cast<std::size_t>(base - keys) + static_cast<std::size_t>(compare(*base, key));
+	}
+
+	// The sorted layout needs nothing beyond the keys.
+	template <typename Key, std::size_t Capacity, flat_layout Layout>
+	class search_index
+	{
+	public:
+		constexpr void rebuild(std::span<const Key>) noexcept
+		{
+		}
+
+		template <typename K, typename Compare>
+		constexpr std::size_t lower_bound(std::span<const Key> keys, const K& key, const Compare& compare) const
+		{
+			return lower_bound_index(keys.data(), keys.size(), key, compare);
+		}
+	};
+
+	template <typename Key, std::size_t Capacity>
+	class search_index<Key, Capacity, flat_layout::eytzinger>
+	{
+		using rank_type = static_vector_detail::size_type_for<Capacity>;
+
+	public:
+		constexpr void rebuild(std::span<const Key> keys)
+		{
+			std::size_t next = 0;
+			assign_ranks(1, keys.size(), next);
+
+			_keys.clear();
+			for (std::size_t node = 0; node < keys.size(); ++node)
+			{
+				_keys.unchecked_push_back(keys[_ranks[node]]);
+			}
+		}
+
+		template <typename K, typename Compare>
+		constexpr std::size_t lower_bound(std::span<const Key> keys, const K& key, const Compare& compare) const
+		{
+			const std::size_t size = _keys.size();
+			const Key* const tree = _keys.data();
+
+			// Nodes are numbered from 1, the children of node n being 2n and 2n + 1. Going right on "less than" and left otherwise,
+			// the walk falls off the tree below the answer.
+			std::size_t node = 1;
+			while (node <= size)
+			{
+				node = 2 * node + static_cast<std::size_t>(compare(tree[node - 1], key));
+			}
+
+			// The last left turn was taken at the answer: drop the right turns below it, and that left turn itself.
+			node >>= std::countr_one(node) + 1;
+
+			return node == 0 ? keys.size() : _ranks[node - 1];
+		}
+
+	private:
+		// An in order walk of the implicit tree visits the nodes in sorted order.
+		constexpr void assign_ranks(std::size_t node, std::size_t size, std::size_t& next) noexcept
+		{
+			if (node <= size)
+			{
+				assign_ranks(2 * node, size, next);
+				_ranks[node - 1] = static_cast<rank_type>(next++);
+				assign_ranks(2 * node + 1, size, next);
+			}
+		}
+
+		static_vector<Key, Capacity> _keys;
+		rank_type _ranks[Capacity]{};
+	};
+
+	// Walks a sorted range against the sorted keys and calls add(element) for every element whose key is neither among the keys nor
+	// equivalent to the last one added. add returns the key it stored, or nullptr to stop the walk, in which case this returns false.
+	template <typename Key, typename Range, typename Projection, typename Compare, typename Add>
+	constexpr bool for_each_new_key(std::span<const Key> keys, Range&& range, Projection projection, const Compare& compare, Add add)
+	{
+		auto existing = keys.begin();
+		const Key* last_added = nullptr;
+
+		for (auto&& element : range)
+		{
+			const auto& key = projection(element);
+
+			if (last_added != nullptr && !compare(*last_added, key))
+			{
+				continue;
+			}
+
+			while (existing != keys.end() && compare(*existing, key))
+			{
+				++existing;
+			}
+
+			if (existing == keys.end() || compare(key, *existing))
+			{
+				last_added = add(element);
+				if (last_added == nullptr)
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	// [0, middle) and [middle, size) are each sorted and share no keys. Works out where every element belongs, then walks the cycles
+	// of that permutation calling exchange(a, b) to swap two positions. A map's keys and values thereby move in lockstep,
+	// with at most size swaps and no memory beyond one index per element.
+	template <std::size_t Capacity, typename Key, typename Compare, typename Exchange>
+	constexpr void merge_runs(const Key* keys, std::size_t middle, std::size_t size, const Compare& compare, Exchange exchange)
+	{
+		static_vector_detail::size_type_for<Capacity> destination[Capacity];
+
+		std::size_t left = 0;
+		std::size_t right = middle;
+		for (std::size_t out = 0; out < size; ++out)
+		{
+			const bool take_right = left == middle || (right != size && compare(keys[right], keys[left]));
+			destination[take_right ? right++ : left++] = static_cast<static_vector_detail::size_type_for<Capacity>>(out);
+		}
+
+		for (std::size_t start = 0; start < size; ++start)
+		{
+			while (destination[start] != start)
+			{
+				const std::size_t target = destination[start];
+				exchange(start, target);
+				std::swap(destination[start], destination[target]);
+			}
+		}
+	}
+}
+
+// A sorted set of unique keys over a static_vector: no allocation, contiguous keys, O(log n) lookups and O(n) single inserts and erases.
+// Meant for small, read-mostly tables where a node based std::set would scatter the keys over the heap.
+// Lookups are branchless, see flat_layout for the search layouts, and insert(sorted_range, keys) merges a whole batch in O(n + m).
+template <typename Key, std::size_t Capacity, typename Compare = std::less<Key>, flat_layout Layout = flat_layout::sorted, typename Policy = static_vector_default_policy>
+class static_flat_set
+{
+	using storage_type = static_vector<Key, Capacity, Policy>;
+
+public:
+
+	using key_type = Key;
+	using value_type = Key;
+	using key_compare = Compare;
+	using value_compare = Compare;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = const value_type&;
+	using const_reference = const value_type&;
+	using iterator = typename storage_type::const_iterator;
+	using const_iterator = typename storage_type::const_iterator;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	constexpr static_flat_set() noexcept (std::is_nothrow_default_constructible_v<Compare>) = default;
+
+	constexpr explicit static_flat_set(const Compare& compare)
+		: _compare(compare)
+	{
+	}
+
+	constexpr static_flat_set(std::initializer_list<Key> keys, const Compare& compare = Compare())
+		: _compare(compare)
+	{
+		insert(keys.begin(), keys.end());
+	}
+
+	template <typename Iterator> requires (std::input_iterator<Iterator>)
+	constexpr static_flat_set(Iterator first, Iterator last, const Compare& compare = Compare())
+		: _compare(compare)
+	{
+		insert(first, last);
+	}
+
+	template <std::ranges::input_range Range>
+	constexpr static_flat_set(sorted_range_t, Range&& keys, const Compare& compare = Compare())
+		: _compare(compare)
+	{
+		insert(sorted_range, std::forward<Range>(keys));
+	}
+
+	constexpr const_iterator begin() const noexcept
+	{
+		return _keys.cbegin();
+	}
+
+	constexpr const_iterator end() const noexcept
+	{
+		return _keys.cend();
+	}
+
+	constexpr const_iterator cbegin() const noexcept
+	{
+		return _keys.cbegin();
+	}
+
+	constexpr const_iterator cend() const noexcept
+	{
+		return _keys.cend();
+	}
+
+	constexpr const_reverse_iterator rbegin() const noexcept
+	{
+		return const_reverse_iterator(end());
+	}
+
+	constexpr const_reverse_iterator rend() const noexcept
+	{
+		return const_reverse_iterator(begin());
+	}
+
+	constexpr std::size_t size() const noexcept
+	{
+		return _keys.size();
+	}
+
+	constexpr bool empty() const noexcept
+	{
+		return _keys.empty();
+	}
+
+	static consteval std::size_t capacity() noexcept
+	{
+		return Capacity;
+	}
+
+	static consteval std::size_t max_size() noexcept
+	{
+		return Capacity;
+	}
+
+	// The keys in ascending order, contiguous.
+	constexpr std::span<const Key> keys() const noexcept
+	{
+		return std::span<const Key>(_keys.data(), _keys.size());
+	}
+
+	constexpr key_compare key_comp() const
+	{
+		return _compare;
+	}
+
+	constexpr value_compare value_comp() const
+	{
+		return _compare;
+	}
+
+	constexpr const_iterator lower_bound(const Key& key) const
+	{
+		return begin() + static_cast<difference_type>(lower_bound_index(key));
+	}
+
+	template <typename K> requires (static_flat_detail::transparent<Compare>)
+	constexpr const_iterator lower_bound(const K& key) const
+	{
+		return begin() + static_cast<difference_type>(lower_bound_index(key));
+	}
+
+	constexpr const_iterator upper_bound(const Key& key) const
+	{
+		return begin() + static_cast<difference_type>(upper_bound_index(key));
+	}
+
+	template <typename K> requires (static_flat_detail::transparent<Compare>)
+	constexpr const_iterator upper_bound(const K& key) const
+	{
+		return begin() + static_cast<difference_type>(upper_bound_index(key));
+	}
+
+	constexpr std::pair<const_iterator, const_iterator> equal_range(const Key& key) const
+	{
+		return { lower_bound(key), upper_bound(key) };
+	}
+
+	constexpr const_iterator find(const Key& key) const
+	{
+		return begin() + static_cast<difference_type>(find_index(key));
+	}
+
+	template <typename K> requires (static_flat_detail::transparent<Compare>)
+	constexpr const_iterator find(const K& key) const
+	{
+		return begin() + static_cast<difference_type>(find_index(key));
+	}
+
+	constexpr bool contains(const Key& key) const
+	{
+		return find_index(key) != size();
+	}
+
+	template <typename K> requires (static_flat_detail::transparent<Compare>)
+	constexpr bool contains(const K& key) const
+	{
+		return find_index(key) != size();
+	}
+
+	constexpr std::size_t count(const Key& key) const
+	{
+		return contains(key) ? 1 : 0;
+	}
+
+	template <typename K> requires (static_flat_detail::transparent<Compare>)
+	constexpr std::size_t count(const K& key) const
+	{
+		return contains(key) ? 1 : 0;
+	}
+
+	// Inserts the key unless an equivalent one is present. When the set is full, the overflow is reported to Policy, and should it return
+	// nothing is inserted and end() comes back with false.
+	template <typename ... Args>
+	constexpr std::pair<const_iterator, bool> emplace(Args&& ... args)
+	{
+		if constexpr (sizeof...(Args) == 1 && (std::is_same_v<std::remove_cvref_t<Args>, Key> && ...))
+		{
+			return insert_unique(std::forward<Args>(args)...);
+		}
+		else
+		{
+			return insert_unique(Key(std::forward<Args>(args)...));
+		}
+	}
+
+	constexpr std::pair<const_iterator, bool> insert(const Key& key)
+	{
+		return insert_unique(key);
+	}
+
+	constexpr std::pair<const_iterator, bool> insert(Key&& key)
+	{
+		return insert_unique(std::move(key));
+	}
+
+	// Inserts the keys one at a time, prefer insert(sorted_range, ...) for input that is already sorted.
+	template <typename Iterator> requires (std::input_iterator<Iterator>)
+	constexpr void insert(Iterator first, Iterator last)
+	{
+		for (; first != last; ++first)
+		{
+			insert_unique(*first);
+		}
+	}
+
+	constexpr void insert(std::initializer_list<Key> keys)
+	{
+		insert(keys.begin(), keys.end());
+	}
+
+	// Merges a range sorted by the set's comparator: the new keys are appended in one pass and then merged with the existing ones
+	// in place, O(size() + size(keys)) instead of a shift per key. If they don't all fit, or a key throws while being appended, the set
+	// is left unchanged; the overflow is reported to Policy.
+	template <std::ranges::input_range Range> requires (std::constructible_from<Key, std::ranges::range_reference_t<Range>>)
+	constexpr void insert(sorted_range_t, Range&& keys)
+	{
+		const std::size_t old_size = size();
+		append_guard guard{ *this, old_size };
+
+		const bool fits = static_flat_detail::for_each_new_key(this->keys(), keys, std::identity(), _compare, [&](auto&& key) -> const Key*
+		{
+			return _keys.size() == Capacity ? nullptr : std::addressof(_keys.unchecked_emplace_back(key));
+		});
+
+		if (!fits) [[unlikely]]
+		{
+			Policy::capacity_exceeded("Flat set lacks the capacity for so many keys!");
+			return;
+		}
+
+		guard.appended = true;
+
+		static_flat_detail::merge_runs<Capacity>(_keys.data(), old_size, _keys.size(), _compare, [&](std::size_t a, std::size_t b)
+		{
+			std::ranges::swap(_keys[a], _keys[b]);
+		});
+		_index.rebuild(this->keys());
+	}
+
+	template <typename Iterator> requires (std::input_iterator<Iterator>)
+	constexpr void insert(sorted_range_t, Iterator first, Iterator last)
+	{
+		insert(sorted_range, std::ranges::subrange(first, last));
+	}
+
+	constexpr const_iterator erase(const_iterator position)
+	{
+		const const_iterator next = _keys.erase(position);
+		_index.rebuild(keys());
+		return next;
+	}
+
+	constexpr const_iterator erase(const_iterator from, const_iterator to)
+	{
+		const const_iterator next = _keys.erase(from, to);
+		_index.rebuild(keys());
+		return next;
+	}
+
+	constexpr std::size_t erase(const Key& key)
+	{
+		return erase_key(key);
+	}
+
+	template <typename K> requires (static_flat_detail::transparent<Compare> && !std::is_convertible_v<K, const_iterator>)
+	constexpr std::size_t erase(const K& key)
+	{
+		return erase_key(key);
+	}
+
+	constexpr void clear() noexcept
+	{
+		_keys.clear();
+		_index.rebuild(keys());
+	}
+
+	constexpr friend bool operator==(const static_flat_set& lhs, const static_flat_set& rhs) requires (std::equality_comparable<Key>)
+	{
+		return lhs._keys == rhs._keys;
+	}
+
+private:
+
+	// Takes back the keys appended past old_size by a bulk insertion that didn't get to merge them, so the keys stay sorted.
+	struct append_guard
+	{
+		static_flat_set& set;
+		std::size_t old_size;
+		bool appended = false;
+
+		constexpr ~append_guard()
+		{
+			if (!appended)
+			{
+				set._keys.truncate(old_size);
+				set._index.rebuild(set.keys());
+			}
+		}
+	};
+
+	template <typename K>
+	constexpr std::size_t lower_bound_index(const K& key) const
+	{
+		return _index.lower_bound(keys(), key, _compare);
+	}
+
+	// Keys are unique, so the upper bound is the lower bound unless that one holds an equivalent key.
+	template <typename K>
+	constexpr std::size_t upper_bound_index(const K& key) const
+	{
+		const std::size_t index = lower_bound_index(key);
+		return index + static_cast<std::size_t>(index != size() && !_compare(key, _keys[index]));
+	}
+
+	template <typename K>
+	constexpr std::size_t find_index(const K& key) const
+	{
+		const std::size_t index = lower_bound_index(key);
+		return index != size() && !_compare(key, _keys[index]) ? index : size();
+	}
+
+	template <typename K>
+	constexpr std::pair<const_iterator, bool> insert_unique(K&& key)
+	{
+		const std::size_t index = lower_bound_index(key);
+
+		if (index != size() && !_compare(key, _keys[index]))
+		{
+			return { begin() + static_cast<difference_type>(index), false };
+		}
+
+		if (size() == Capacity) [[unlikely]]
+		{
+			Policy::capacity_exceeded("Flat set is at full capacity, insertion not allowed!");
+			return { end(), false };
+		}
+
+		_keys.emplace(_keys.begin() + static_cast<difference_type>(index), std::forward<K>(key));
+		_index.rebuild(keys());
+
+		return { begin() + static_cast<difference_type>(index), true };
+	}
+
+	template <typename K>
+	constexpr std::size_t erase_key(const K& key)
+	{
+		const std::size_t index = find_index(key);
+		if (index == size())
+		{
+			return 0;
+		}
+
+		erase(begin() + static_cast<difference_type>(index));
+		return 1;
+	}
+
+	storage_type _keys;
+	[[no_unique_address]] static_flat_detail::search_index<Key, Capacity, Layout> _index;
+	[[no_unique_address]] Compare _compare;
+};
+
+namespace static_flat_set_static_assertions
+{
+	static_assert(static_flat_detail::lower_bound_index(std::array{ 1, 3, 5, 7 }.data(), 4, 0, std::less<>()) == 0);
+	static_assert(static_flat_detail::lower_bound_index(std::array{ 1, 3, 5, 7 }.data(), 4, 5, std::less<>()) == 2);
+	static_assert(static_flat_detail::lower_bound_index(std::array{ 1, 3, 5, 7 }.data(), 4, 6, std::less<>()) == 3);
+	static_assert(static_flat_detail::lower_bound_index(std::array{ 1, 3, 5, 7 }.data(), 4, 8, std::less<>()) == 4);
+
+	// The sorted layout stores nothing beyond the keys.
+	static_assert(sizeof(static_flat_set<int, 8>) == sizeof(static_vector<int, 8>));
+
+	// Erasing an empty range leaves every key in place.
+	constexpr bool erases_nothing()
+	{
+		static_flat_set<std::string, 4> words{ "alpha", "beta", "gamma" };
+		words.erase(words.begin(), words.begin());
+		return words.size() == 3 && *words.begin() == "alpha" && words.contains("gamma");
+	}
+
+	static_assert(erases_nothing());
+
+	// A bulk insertion that can't append all of its keys takes back the ones it did, so the keys stay sorted. A key constructor
+	// throwing halfway unwinds through the same path, but can't be thrown in a constant expression.
+	constexpr bool unappends_keys()
+	{
+		static_flat_set<std::string, 4, std::less<>, flat_layout::sorted, static_vector_saturate_policy> words{ "beta", "delta", "gamma" };
+		words.insert(sorted_range, std::array<std::string, 2>{ "alpha", "epsilon" });
+		return words.size() == 3 && *words.begin() == "beta" && words.contains("gamma") && !words.contains("alpha");
+	}
+
+	static_assert(unappends_keys());
+}
@@ -0,0 +1,290 @@
+#pragma once
+
+#include "static_vector.hpp"
+
+#include <atomic>
+#include <optional>
+
+// A bounded lock free multi producer, multi consumer FIFO over inline storage (Dmitry Vyukov's design), with no heap use.
+// Every slot carries a sequence number telling whose turn it is: a producer at position pos may fill the slot once its sequence
+// is pos, and a consumer may empty it once its sequence is pos + 1. Producers and consumers therefore only contend on their own
+// position counter, and on a slot when the queue is (nearly) full or empty. Slots are padded to a cache line, so that threads
+// working on neighbouring slots don't invalidate each other's lines.
+//
+// try_push and try_pop never block. push and pop spin for a short while and then sleep on the slot's sequence number
+// (std::atomic::wait, a futex on Linux), which is why every sequence update is followed by a notify.
+template <typename T, std::size_t Capacity>
+class static_mpmc_queue
+{
+	static_assert(Capacity > 0, "static_mpmc_queue needs room for at least one element");
+	// Once a position is claimed it has to be filled or emptied, other threads may already be waiting on it,
+	// so the steps taken after claiming one must not throw.
+	static_assert(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>, "static_mpmc_queue needs nothrow move construction and destruction");
+
+	static constexpr std::size_t cache_line = static_vector_detail::cache_line_bytes;
+
+	// How many times a blocking operation polls before going to sleep.
+	static constexpr int spin_limit = 64;
+
+	struct alignas(std::max(cache_line, alignof(T))) slot
+	{
+		std::atomic<std::size_t> sequence;
+		std::aligned_storage_t<sizeof(T), alignof(T)> storage;
+
+		T* get() noexcept
+		{
+			return std::launder(reinterpret_cast<T*>(&storage));
+		}
+	};
+
+public:
+
+	using value_type = T;
+	using size_type = std::size_t;
+	using reference = value_type&;
+	using const_reference = const value_type&;
+
+	static_mpmc_queue() noexcept
+	{
+		for (std::size_t i = 0; i < Capacity; ++i)
+		{
+			_slots[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	static_mpmc_queue(const static_mpmc_queue&) = delete;
+	static_mpmc_queue& operator=(const static_mpmc_queue&) = delete;
+
+	// Must not run concurrently with any other operation.
+	~static_mpmc_queue()
+	{
+		if constexpr (!std::is_trivially_destructible_v<T>)
+		{
+			const std::size_t end = _enqueue_position.load(std::memory_order_acquire);
+			for (std::size_t position = _dequeue_position.load(std::memory_order_relaxed); position != end; ++position)
+			{
+				std::destroy_at(_slots[wrap(position)].get());
+			}
+		}
+	}
+
+	static consteval std::size_t capacity() noexcept
+	{
+		return Capacity;
+	}
+
+	// Only a snapshot. It counts claimed positions, so elements still being constructed or destroyed are included.
+	std::size_t size_approx() const noexcept
+	{
+		const std::size_t dequeued = _dequeue_position.load(std::memory_order_acquire);
+		const std::size_t enqueued = _enqueue_position.load(std::memory_order_acquire);
+		return enqueued > dequeued ? std::min(enqueued - dequeued, Capacity) : 0;
+	}
+
+	bool empty() const noexcept
+	{
+		return size_approx() == 0;
+	}
+
+	// Constructs an element at the back, returns false if the queue is full.
+	template <typename ... Args>
+	bool try_emplace(Args&& ... args) noexcept (std::is_nothrow_constructible_v<T, Args...>)
+	{
+		if constexpr (!std::is_nothrow_constructible_v<T, Args...>)
+		{
+			// Built before claiming a position, so that a throwing constructor leaves the queue untouched.
+			return try_emplace(T(std::forward<Args>(args)...));
+		}
+
+		std::size_t position = _enqueue_position.load(std::memory_order_relaxed);
+
+		for (;;)
+		{
+			slot& target = _slots[wrap(position)];
+			const std::size_t sequence = target.sequence.load(std::memory_order_acquire);
+			const auto lag = static_cast<std::ptrdiff_t>(sequence - position);
+
+			if (lag == 0)
+			{
+				if (_enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				{
+					fill(target, position, std::forward<Args>(args)...);
+					return true;
+				}
+			}
+			else if (lag < 0)
+			{
+				// The slot still holds the element from the previous lap.
+				return false;
+			}
+			else
+			{
+				position = _enqueue_position.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	bool try_push(const T& value) noexcept (std::is_nothrow_copy_constructible_v<T>)
+	{
+		return try_emplace(value);
+	}
+
+	bool try_push(T&& value) noexcept (std::is_nothrow_move_constructible_v<T>)
+	{
+		return try_emplace(std::move(value));
+	}
+
+	// Moves the front element into value, returns false if the queue is empty.
+	bool try_pop(T& value) noexcept requires (std::is_nothrow_move_assignable_v<T>)
+	{
+		return try_consume([&](T& element) noexcept
+		{
+			value = std::move(element);
+		});
+	}
+
+	std::optional<T> try_pop() noexcept
+	{
+		std::optional<T> value;
+
+		try_consume([&](T& element) noexcept
+		{
+			value.emplace(std::move(element));
+		});
+
+		return value;
+	}
+
+	// Claims the next position and waits for its slot to be free, spinning first and then sleeping.
+	template <typename ... Args>
+	void emplace(Args&& ... args) noexcept (std::is_nothrow_constructible_v<T, Args...>)
+	{
+		if constexpr (!std::is_nothrow_constructible_v<T, Args...>)
+		{
+			return emplace(T(std::forward<Args>(args)...));
+		}
+
+		const std::size_t position = _enqueue_position.fetch_add(1, std::memory_order_relaxed);
+		slot& target = _slots[wrap(position)];
+
+		wait_for(target, position);
+		fill(target, position, std::forward<Args>(args)...);
+	}
+
+	void push(const T& value) noexcept (std::is_nothrow_copy_constructible_v<T>)
+	{
+		emplace(value);
+	}
+
+	void push(T&& value) noexcept (std::is_nothrow_move_constructible_v<T>)
+	{
+		emplace(std::move(value));
+	}
+
+	// Claims the next position and waits for its element to arrive, spinning first and then sleeping.
+	T pop() noexcept
+	{
+		const std::size_t position = _dequeue_position.fetch_add(1, std::memory_order_relaxed);
+		slot& source = _slots[wrap(position)];
+
+		wait_for(source, position + 1);
+
+		T value(std::move(*source.get()));
+		empty_slot(source, position);
+
+		return value;
+	}
+
+private:
+
+	static constexpr std::size_t wrap(std::size_t position) noexcept
+	{
+		return position % Capacity;
+	}
+
+	static void cpu_relax() noexcept
+	{
+#if STATIC_VECTOR_HAS_SIMD
+		_mm_pause();
+#endif
+	}
+
+	// Claims the front position if its element is there and hands the element to consume before destroying it.
+	template <typename Consume>
+	bool try_consume(Consume consume) noexcept
+	{
+		std::size_t position = _dequeue_position.load(std::memory_order_relaxed);
+
+		for (;;)
+		{
+			slot& source = _slots[wrap(position)];
+			const std::size_t sequence = source.sequence.load(std::memory_order_acquire);
+			const auto lag = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+
+			if (lag == 0)
+			{
+				if (_dequeue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				{
+					consume(*source.get());
+					empty_slot(source, position);
+					return true;
+				}
+			}
+			else if (lag < 0)
+			{
+				// Not filled yet for this lap.
+				return false;
+			}
+			else
+			{
+				position = _dequeue_position.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	static void wait_for(slot& target, std::size_t sequence) noexcept
+	{
+		for (int spins = 0;; ++spins)
+		{
+			const std::size_t current = target.sequence.load(std::memory_order_acquire);
+			if (current == sequence)
+			{
+				return;
+			}
+
+			if (spins < spin_limit)
+			{
+				cpu_relax();
+			}
+			else
+			{
+				target.sequence.wait(current, std::memory_order_acquire);
+			}
+		}
+	}
+
+	template <typename ... Args>
+	static void fill(slot& target, std::size_t position, Args&& ... args) noexcept
+	{
+		std::construct_at(target.get(), std::forward<Args>(args)...);
+		target.sequence.store(position + 1, std::memory_order_release);
+		target.sequence.notify_all();
+	}
+
+	static void empty_slot(slot& source, std::size_t position) noexcept
+	{
+		std::destroy_at(source.get());
+		source.sequence.store(position + Capacity, std::memory_order_release);
+		source.sequence.notify_all();
+	}
+
+	alignas(cache_line) std::atomic<std::size_t> _enqueue_position = 0;
+	alignas(cache_line) std::atomic<std::size_t> _dequeue_position = 0;
+	slot _slots[Capacity];
+};
+
+namespace static_mpmc_queue_static_assertions
+{
+	// Each slot gets a cache line of its own, as do the two position counters.
+	static_assert(sizeof(static_mpmc_queue<int, 4>) == 6 * static_vector_detail::cache_line_bytes);
+}
@@ -0,0 +1,641 @@
+#pragma once
+
+#include "static_vector.hpp"
+
+#include <span>
+
+// A fixed capacity double ended queue over the same uninitialized inline storage as static_vector. The elements occupy a circular
+// window of the buffer starting at the front, so pushing and popping at either end is O(1) and never shifts anything.
+// When the buffer is full, Overwrite_Oldest decides what a push does: by default it is an overflow reported to Policy, otherwise
+// the element at the opposite end is dropped to make room, which is what a flight recorder keeping the latest entries wants.
+// The contents are exposed as (at most) two contiguous spans, see spans().
+template <typename T, std::size_t Capacity, bool Overwrite_Oldest = false, typename Policy = static_vector_default_policy>
+class static_ring_buffer
+{
+	static_assert(Capacity > 0, "static_ring_buffer needs room for at least one element");
+
+	using size_field_type = static_vector_detail::size_type_for<Capacity>;
+
+	// With a power of two capacity, wrapping an index is a mask, otherwise a compare and subtract.
+	static constexpr bool is_power_of_two = std::has_single_bit(Capacity);
+
+	std::aligned_storage_t<sizeof(T), alignof(T)> _data[Capacity];
+	size_field_type _head = 0;
+	size_field_type _size = 0;
+
+	template <bool Const>
+	struct basic_iterator
+	{
+		using buffer_type = std::conditional_t<Const, const static_ring_buffer, static_ring_buffer>;
+
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using iterator_concept = std::random_access_iterator_tag;
+		using difference_type = std::ptrdiff_t;
+		using value_type = T;
+		using pointer = std::conditional_t<Const, const T*, T*>;
+		using reference = std::conditional_t<Const, const T&, T&>;
+
+		constexpr basic_iterator() noexcept = default;
+
+		template <bool Other_Const> requires (Const && !Other_Const)
+		constexpr basic_iterator(const basic_iterator<Other_Const>& other) noexcept
+			: _buffer(other._buffer), _offset(other._offset)
+		{
+		}
+
+		constexpr reference operator*() const noexcept
+		{
+			return (*_buffer)[_offset];
+		}
+
+		constexpr pointer operator->() const noexcept
+		{
+			return std::addressof((*_buffer)[_offset]);
+		}
+
+		constexpr reference operator[](difference_type offset) const noexcept
+		{
+			return (*_buffer)[static_cast<std::size_t>(static_cast<difference_type>(_offset) + offset)];
+		}
+
+		constexpr basic_iterator& operator++() noexcept
+		{
+			++_offset;
+			return *this;
+		}
+
+		constexpr basic_iterator operator++(int) noexcept
+		{
+			basic_iterator copy = *this;
+			++_offset;
+			return copy;
+		}
+
+		constexpr basic_iterator& operator--() noexcept
+		{
+			--_offset;
+			return *this;
+		}
+
+		constexpr basic_iterator operator--(int) noexcept
+		{
+			basic_iterator copy = *this;
+			--_offset;
+			return copy;
+		}
+
+		constexpr basic_iterator& operator+=(difference_type offset) noexcept
+		{
+			_offset = static_cast<std::size_t>(static_cast<difference_type>(_offset) + offset);
+			return *this;
+		}
+
+		constexpr basic_iterator& operator-=(difference_type offset) noexcept
+		{
+			return *this += -offset;
+		}
+
+		constexpr friend basic_iterator operator+(basic_iterator it, difference_type offset) noexcept
+		{
+			return it += offset;
+		}
+
+		constexpr friend basic_iterator operator+(difference_type offset, basic_iterator it) noexcept
+		{
+			return it += offset;
+		}
+
+		constexpr friend basic_iterator operator-(basic_iterator it, difference_type offset) noexcept
+		{
+			return it -= offset;
+		}
+
+		constexpr friend difference_type operator-(const basic_iterator& a, const basic_iterator& b) noexcept
+		{
+			return static_cast<difference_type>(a._offset) - static_cast<difference_type>(b._offset);
+		}
+
+		constexpr friend bool operator==(const basic_iterator& a, const basic_iterator& b) noexcept
+		{
+			return a._offset == b._offset;
+		}
+
+		constexpr friend auto operator<=>(const basic_iterator& a, const basic_iterator& b) noexcept
+		{
+			return a._offset <=> b._offset;
+		}
+
+	private:
+		friend class static_ring_buffer;
+		friend struct basic_iterator<true>;
+
+		constexpr basic_iterator(buffer_type* buffer, std::size_t offset) noexcept
+			: _buffer(buffer), _offset(offset)
+		{
+		}
+
+		// Iterators hold a position relative to the front, so they are invalidated by pushing or popping at the front.
+		buffer_type* _buffer = nullptr;
+		std::size_t _offset = 0;
+	};
+
+public:
+
+	using value_type = T;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = value_type&;
+	using const_reference = const value_type&;
+	using pointer = T*;
+	using const_pointer = const T*;
+	using iterator = basic_iterator<false>;
+	using const_iterator = basic_iterator<true>;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	constexpr static_ring_buffer() noexcept = default;
+
+	constexpr static_ring_buffer(std::initializer_list<T> values) requires (std::is_copy_constructible_v<T>)
+	{
+		for (const T& value : values)
+		{
+			push_back(value);
+		}
+	}
+
+	constexpr static_ring_buffer(const static_ring_buffer& other) noexcept (std::is_nothrow_copy_constructible_v<T>) requires (std::is_copy_constructible_v<T>)
+	{
+		for (const T& value : other)
+		{
+			unchecked_emplace_back(value);
+		}
+	}
+
+	constexpr static_ring_buffer(static_ring_buffer&& other) noexcept (std::is_nothrow_move_constructible_v<T> || is_trivially_relocatable_v<T>)
+		requires (std::is_move_constructible_v<T>)
+	{
+		take(other);
+	}
+
+	constexpr static_ring_buffer& operator=(const static_ring_buffer& other) requires (std::is_copy_constructible_v<T>)
+	{
+		if (this != &other)
+		{
+			clear();
+			for (const T& value : other)
+			{
+				unchecked_emplace_back(value);
+			}
+		}
+
+		return *this;
+	}
+
+	constexpr static_ring_buffer& operator=(static_ring_buffer&& other) noexcept (std::is_nothrow_move_constructible_v<T> || is_trivially_relocatable_v<T>)
+		requires (std::is_move_constructible_v<T>)
+	{
+		if (this != &other)
+		{
+			clear();
+			take(other);
+		}
+
+		return *this;
+	}
+
+	constexpr ~static_ring_buffer() noexcept requires (std::is_trivially_destructible_v<T>) = default;
+	constexpr ~static_ring_buffer() noexcept (std::is_nothrow_destructible_v<T>) requires (!std::is_trivially_destructible_v<T>)
+	{
+		clear();
+	}
+
+	constexpr iterator begin() noexcept
+	{
+		return iterator(this, 0);
+	}
+	constexpr iterator end() noexcept
+	{
+		return iterator(this, _size);
+	}
+	constexpr const_iterator begin() const noexcept
+	{
+		return const_iterator(this, 0);
+	}
+	constexpr const_iterator end() const noexcept
+	{
+		return const_iterator(this, _size);
+	}
+	constexpr const_iterator cbegin() const noexcept
+	{
+		return begin();
+	}
+	constexpr const_iterator cend() const noexcept
+	{
+		return end();
+	}
+	constexpr reverse_iterator rbegin() noexcept
+	{
+		return reverse_iterator(end());
+	}
+	constexpr reverse_iterator rend() noexcept
+	{
+		return reverse_iterator(begin());
+	}
+	constexpr const_reverse_iterator rbegin() const noexcept
+	{
+		return const_reverse_iterator(end());
+	}
+	constexpr const_reverse_iterator rend() const noexcept
+	{
+		return const_reverse_iterator(begin());
+	}
+	constexpr const_reverse_iterator crbegin() const noexcept
+	{
+		return rbegin();
+	}
+	constexpr const_reverse_iterator crend() const noexcept
+	{
+		return rend();
+	}
+
+	constexpr std::size_t size() const noexcept
+	{
+		return _size;
+	}
+
+	consteval std::size_t capacity() const noexcept
+	{
+		return Capacity;
+	}
+
+	consteval std::size_t max_size() const noexcept
+	{
+		return Capacity;
+	}
+
+	constexpr bool empty() const noexcept
+	{
+		return _size == 0;
+	}
+
+	constexpr bool full() const noexcept
+	{
+		return _size == Capacity;
+	}
+
+	constexpr std::size_t free_space() const noexcept
+	{
+		return Capacity - _size;
+	}
+
+	// Element index is counted from the front.
+	constexpr reference operator[](std::size_t index) noexcept (!Policy::checks_indexing || Policy::is_nothrow)
+	{
+		if constexpr (Policy::checks_indexing)
+		{
+			if (index >= _size) [[unlikely]]
+			{
+				Policy::out_of_range("Index out of bounds!");
+			}
+		}
+
+		return *slot(index);
+	}
+
+	constexpr const_reference operator[](std::size_t index) const noexcept (!Policy::checks_indexing || Policy::is_nothrow)
+	{
+		if constexpr (Policy::checks_indexing)
+		{
+			if (index >= _size) [[unlikely]]
+			{
+				Policy::out_of_range("Index out of bounds!");
+			}
+		}
+
+		return *slot(index);
+	}
+
+	constexpr reference at(std::size_t index) noexcept (Policy::is_nothrow)
+	{
+		if (index >= _size) [[unlikely]]
+		{
+			Policy::out_of_range("Index out of bounds!");
+		}
+
+		return *slot(index);
+	}
+
+	constexpr const_reference at(std::size_t index) const noexcept (Policy::is_nothrow)
+	{
+		if (index >= _size) [[unlikely]]
+		{
+			Policy::out_of_range("Index out of bounds!");
+		}
+
+		return *slot(index);
+	}
+
+	constexpr reference front() noexcept
+	{
+		return *slot(0);
+	}
+
+	constexpr const_reference front() const noexcept
+	{
+		return *slot(0);
+	}
+
+	constexpr reference back() noexcept
+	{
+		return *slot(_size - 1);
+	}
+
+	constexpr const_reference back() const noexcept
+	{
+		return *slot(_size - 1);
+	}
+
+	// The elements in order as two contiguous runs of the buffer: the front up to the end of the buffer, then the wrapped around rest.
+	// The second span is empty when the contents don't wrap.
+	constexpr std::pair<std::span<T>, std::span<T>> spans() noexcept
+	{
+		const std::size_t first = std::min<std::size_t>(_size, Capacity - _head);
+		return { std::span<T>(slot(0), first), std::span<T>(data(), _size - first) };
+	}
+
+	constexpr std::pair<std::span<const T>, std::span<const T>> spans() const noexcept
+	{
+		const std::size_t first = std::min<std::size_t>(_size, Capacity - _head);
+		return { std::span<const T>(slot(0), first), std::span<const T>(data(), _size - first) };
+	}
+
+	constexpr void push_back(const T& value)
+	{
+		emplace_back(value);
+	}
+
+	constexpr void push_back(T&& value)
+	{
+		emplace_back(std::move(value));
+	}
+
+	constexpr void push_front(const T& value)
+	{
+		emplace_front(value);
+	}
+
+	constexpr void push_front(T&& value)
+	{
+		emplace_front(std::move(value));
+	}
+
+	// When full, either reports the overflow to Policy (and drops the new element if it returns) or, in Overwrite_Oldest mode,
+	// replaces the front element, which becomes the new back.
+	template <typename ... Args>
+	constexpr reference emplace_back(Args&& ... args)
+	{
+		if (full()) [[unlikely]]
+		{
+			if constexpr (Overwrite_Oldest)
+			{
+				T* const oldest = slot(0);
+				replace(oldest, std::forward<Args>(args)...);
+				_head = static_cast<size_field_type>(wrap(_head + std::size_t{ 1 }));
+				return *oldest;
+			}
+			else
+			{
+				Policy::capacity_exceeded("Ring buffer is full, push back not allowed!");
+				return back();
+			}
+		}
+
+		return unchecked_emplace_back(std::forward<Args>(args)...);
+	}
+
+	// The mirror image of emplace_back: in Overwrite_Oldest mode a full buffer drops its back element.
+	template <typename ... Args>
+	constexpr reference emplace_front(Args&& ... args)
+	{
+		if (full()) [[unlikely]]
+		{
+			if constexpr (Overwrite_Oldest)
+			{
+				T* const newest = slot(_size - 1);
+				replace(newest, std::forward<Args>(args)...);
+				_head = static_cast<size_field_type>(wrap(_head + Capacity - 1));
+				return *newest;
+			}
+			else
+			{
+				Policy::capacity_exceeded("Ring buffer is full, push front not allowed!");
+				return front();
+			}
+		}
+
+		T* const element = std::construct_at(slot(Capacity - 1), std::forward<Args>(args)...);
+		_head = static_cast<size_field_type>(wrap(_head + Capacity - 1));
+		_size++;
+
+		return *element;
+	}
+
+	// Returns a pointer to the new element, or nullptr without touching the buffer if it is full, whatever the mode.
+	template <typename ... Args>
+	constexpr pointer try_emplace_back(Args&& ... args) noexcept (std::is_nothrow_constructible_v<T, Args...>)
+	{
+		if (full())
+		{
+			return nullptr;
+		}
+
+		return std::addressof(unchecked_emplace_back(std::forward<Args>(args)...));
+	}
+
+	constexpr pointer try_push_back(const T& value) noexcept (std::is_nothrow_copy_constructible_v<T>)
+	{
+		return try_emplace_back(value);
+	}
+
+	constexpr pointer try_push_back(T&& value) noexcept (std::is_nothrow_move_constructible_v<T>)
+	{
+		return try_emplace_back(std::move(value));
+	}
+
+	constexpr void pop_front() noexcept (std::is_nothrow_destructible_v<T> && Policy::is_nothrow)
+	{
+		if (empty()) [[unlikely]]
+		{
+			Policy::out_of_range("Can't pop from empty ring buffer!");
+		}
+
+		std::destroy_at(slot(0));
+		_head = static_cast<size_field_type>(wrap(_head + std::size_t{ 1 }));
+		_size--;
+	}
+
+	constexpr void pop_back() noexcept (std::is_nothrow_destructible_v<T> && Policy::is_nothrow)
+	{
+		if (empty()) [[unlikely]]
+		{
+			Policy::out_of_range("Can't pop from empty ring buffer!");
+		}
+
+		std::destroy_at(slot(_size - 1));
+		_size--;
+	}
+
+	// Removes the first count elements, e.g. after a batch taken from spans() has been processed.
+	constexpr void pop_front(std::size_t count) noexcept (std::is_nothrow_destructible_v<T> && Policy::is_nothrow)
+	{
+		if (count > _size) [[unlikely]]
+		{
+			Policy::out_of_range("Can't pop more elements than the ring buffer holds!");
+		}
+
+		if constexpr (!std::is_trivially_destructible_v<T>)
+		{
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				std::destroy_at(slot(i));
+			}
+		}
+
+		_head = static_cast<size_field_type>(wrap(_head + count));
+		_size = static_cast<size_field_type>(_size - count);
+	}
+
+	constexpr void clear() noexcept (std::is_nothrow_destructible_v<T>)
+	{
+		if constexpr (!std::is_trivially_destructible_v<T>)
+		{
+			const auto [first, second] = spans();
+			std::destroy(first.begin(), first.end());
+			std::destroy(second.begin(), second.end());
+		}
+
+		_head = 0;
+		_size = 0;
+	}
+
+	constexpr void swap(static_ring_buffer& other) noexcept (std::is_nothrow_move_constructible_v<T> || is_trivially_relocatable_v<T>)
+		requires (std::is_move_constructible_v<T>)
+	{
+		if (this != &other)
+		{
+			static_ring_buffer temporary(std::move(other));
+			other = std::move(*this);
+			*this = std::move(temporary);
+		}
+	}
+
+private:
+
+	static constexpr std::size_t wrap(std::size_t index) noexcept
+	{
+		if constexpr (is_power_of_two)
+		{
+			return index & (Capacity - 1);
+		}
+		else
+		{
+			// Indices handed in are always below 2 * Capacity.
+			return index >= Capacity ? index - Capacity : index;
+		}
+	}
+
+	constexpr T* data() noexcept
+	{
+		return std::launder(reinterpret_cast<T*>(_data));
+	}
+
+	constexpr const T* data() const noexcept
+	{
+		return std::launder(reinterpret_cast<const T*>(_data));
+	}
+
+	// The slot holding the element offset positions after the front.
+	constexpr T* slot(std::size_t offset) noexcept
+	{
+		return data() + wrap(_head + offset);
+	}
+
+	constexpr const T* slot(std::size_t offset) const noexcept
+	{
+		return data() + wrap(_head + offset);
+	}
+
+	// Moves other's elements into this empty buffer and leaves other empty. Trivially relocatable elements keep their slots,
+	// so this is a copy of the two live spans.
+	constexpr void take(static_ring_buffer& other) noexcept (std::is_nothrow_move_constructible_v<T> || is_trivially_relocatable_v<T>)
+	{
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			const auto [first, second] = other.spans();
+			_head = other._head;
+			static_vector_detail::relocate_n(first.data(), first.size(), slot(0));
+			static_vector_detail::relocate_n(second.data(), second.size(), data());
+			_size = other._size;
+			other._head = 0;
+			other._size = 0;
+		}
+		else
+		{
+			for (T& value : other)
+			{
+				unchecked_emplace_back(std::move(value));
+			}
+			other.clear();
+		}
+	}
+
+	template <typename ... Args>
+	constexpr reference unchecked_emplace_back(Args&& ... args) noexcept (std::is_nothrow_constructible_v<T, Args...>)
+	{
+		static_vector_detail::debug_check(!full(), "unchecked_emplace_back on a full static_ring_buffer");
+
+		T* const element = std::construct_at(slot(_size), std::forward<Args>(args)...);
+		_size++;
+
+		return *element;
+	}
+
+	// Overwrites a live element. The new value is built first, since the arguments may refer to the element being replaced.
+	template <typename ... Args>
+	static constexpr void replace(T* element, Args&& ... args)
+	{
+		if constexpr (std::is_move_assignable_v<T>)
+		{
+			*element = T(std::forward<Args>(args)...);
+		}
+		else
+		{
+			T value(std::forward<Args>(args)...);
+			std::destroy_at(element);
+			std::construct_at(element, std::move(value));
+		}
+	}
+};
+
+template <typename T, std::size_t Capacity, bool Overwrite_Oldest, typename Policy> requires (std::equality_comparable<T>)
+constexpr bool operator==(const static_ring_buffer<T, Capacity, Overwrite_Oldest, Policy>& lhs, const static_ring_buffer<T, Capacity, Overwrite_Oldest, Policy>& rhs)
+{
+	return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename T, std::size_t Capacity, bool Overwrite_Oldest, typename Policy> requires (std::is_move_constructible_v<T>)
+constexpr void swap(static_ring_buffer<T, Capacity, Overwrite_Oldest, Policy>& lhs, static_ring_buffer<T, Capacity, Overwrite_Oldest, Policy>& rhs) noexcept (noexcept(lhs.swap(rhs)))
+{
+	lhs.swap(rhs);
+}
+
+namespace static_ring_buffer_static_assertions
+{
+	static_assert(std::random_access_iterator<static_ring_buffer<int, 8>::iterator>);
+	static_assert(std::random_access_iterator<static_ring_buffer<int, 8>::const_iterator>);
+	static_assert(std::is_trivially_destructible_v<static_ring_buffer<int, 8>>);
+	static_assert(!std::is_trivially_destructible_v<static_ring_buffer<std::string, 8>>);
+	static_assert(sizeof(static_ring_buffer<std::uint8_t, 14>) == 16);
+	static_assert(std::is_nothrow_move_constructible_v<static_ring_buffer<std::unique_ptr<int>, 8>>);
+}
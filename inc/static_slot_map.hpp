@@ -0,0 +1,283 @@
+#pragma once
+
+#include "static_vector.hpp"
+
+#include <span>
+
+// A fixed capacity object pool handing out stable {index, generation} handles, with O(1) insert, erase and lookup and no allocation.
+//
+// The objects themselves are kept dense in a static_vector, so iterating over them is a plain array walk. A handle instead names
+// a slot, which holds the position of its object in that array; erasing moves the last object into the hole and repoints its slot.
+// Slots of erased objects are threaded into an intrusive free list through that same position field, and reused first.
+// Erasing bumps the slot's generation, so handles to the erased object stop resolving rather than reaching whatever reuses the slot.
+//
+// Capacity and error handling follow static_vector: overflows are reported to Policy::capacity_exceeded, stale handles passed to at()
+// to Policy::out_of_range.
+template <typename T, std::size_t Capacity, typename Policy = static_vector_default_policy>
+class static_slot_map
+{
+	static_assert(Capacity > 0, "static_slot_map needs room for at least one element");
+
+	using values_type = static_vector<T, Capacity, Policy>;
+	using index_type = static_vector_detail::size_type_for<Capacity>;
+
+	// Ends the free list. Slot indices are below Capacity, so it can't be mistaken for one.
+	static constexpr index_type no_slot = static_cast<index_type>(Capacity);
+
+public:
+
+	using generation_type = std::uint32_t;
+
+	// Names an object for as long as it isn't erased. A default constructed handle never resolves, slots start at generation 1.
+	struct handle
+	{
+		index_type index = 0;
+		generation_type generation = 0;
+
+		constexpr friend bool operator==(const handle&, const handle&) noexcept = default;
+	};
+
+	using value_type = T;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = T&;
+	using const_reference = const T&;
+	using pointer = T*;
+	using const_pointer = const T*;
+	using iterator = typename values_type::iterator;
+	using const_iterator = typename values_type::const_iterator;
+
+	constexpr static_slot_map() noexcept = default;
+
+	constexpr std::size_t size() const noexcept
+	{
+		return _values.size();
+	}
+
+	constexpr bool empty() const noexcept
+	{
+		return _values.empty();
+	}
+
+	consteval std::size_t max_size() const noexcept
+	{
+		return Capacity;
+	}
+
+	consteval std::size_t capacity() const noexcept
+	{
+		return Capacity;
+	}
+
+	// The objects, densely packed in no particular order. Erasing reorders them.
+	constexpr iterator begin() noexcept
+	{
+		return _values.begin();
+	}
+
+	constexpr const_iterator begin() const noexcept
+	{
+		return _values.begin();
+	}
+
+	constexpr iterator end() noexcept
+	{
+		return _values.end();
+	}
+
+	constexpr const_iterator end() const noexcept
+	{
+		return _values.end();
+	}
+
+	constexpr const_iterator cbegin() const noexcept
+	{
+		return _values.cbegin();
+	}
+
+	constexpr const_iterator cend() const noexcept
+	{
+		return _values.cend();
+	}
+
+	constexpr std::span<T> values() noexcept
+	{
+		return std::span<T>(_values.data(), _values.size());
+	}
+
+	constexpr std::span<const T> values() const noexcept
+	{
+		return std::span<const T>(_values.data(), _values.size());
+	}
+
+	// The handle of the object at a position of the dense array, for going from iteration back to handles.
+	constexpr handle handle_at(std::size_t position) const noexcept
+	{
+		const index_type slot = _slot_of[position];
+		return handle{ slot, _slots[slot].generation };
+	}
+
+	// Constructs an object and returns its handle. When the map is full, the overflow is reported to Policy, and should it return
+	// nothing is inserted and a handle that never resolves comes back.
+	template <typename ... Args>
+	constexpr handle emplace(Args&& ... args)
+	{
+		if (_values.size() == Capacity) [[unlikely]]
+		{
+			Policy::capacity_exceeded("Slot map is at full capacity, insertion not allowed!");
+			return handle{};
+		}
+
+		_values.unchecked_emplace_back(std::forward<Args>(args)...);
+
+		const index_type slot = take_free_slot();
+		const index_type position = static_cast<index_type>(_values.size() - 1);
+
+		_slots[slot].position = position;
+		_slot_of[position] = slot;
+
+		return handle{ slot, _slots[slot].generation };
+	}
+
+	constexpr handle insert(const T& value)
+	{
+		return emplace(value);
+	}
+
+	constexpr handle insert(T&& value)
+	{
+		return emplace(std::move(value));
+	}
+
+	constexpr bool contains(handle key) const noexcept
+	{
+		return key.index < _slots_used && _slots[key.index].generation == key.generation;
+	}
+
+	// The object key names, or nullptr if it was erased.
+	constexpr T* find(handle key) noexcept
+	{
+		return contains(key) ? std::addressof(_values[_slots[key.index].position]) : nullptr;
+	}
+
+	constexpr const T* find(handle key) const noexcept
+	{
+		return contains(key) ? std::addressof(_values[_slots[key.index].position]) : nullptr;
+	}
+
+	constexpr T& at(handle key) noexcept (Policy::is_nothrow)
+	{
+		if (!contains(key)) [[unlikely]]
+		{
+			Policy::out_of_range("Handle doesn't name an object of the slot map!");
+		}
+		return _values[_slots[key.index].position];
+	}
+
+	constexpr const T& at(handle key) const noexcept (Policy::is_nothrow)
+	{
+		if (!contains(key)) [[unlikely]]
+		{
+			Policy::out_of_range("Handle doesn't name an object of the slot map!");
+		}
+		return _values[_slots[key.index].position];
+	}
+
+	// Unchecked, key must name an object.
+	constexpr T& operator[](handle key) noexcept
+	{
+		static_vector_detail::debug_check(contains(key), "stale handle passed to static_slot_map::operator[]");
+		return _values[_slots[key.index].position];
+	}
+
+	constexpr const T& operator[](handle key) const noexcept
+	{
+		static_vector_detail::debug_check(contains(key), "stale handle passed to static_slot_map::operator[]");
+		return _values[_slots[key.index].position];
+	}
+
+	// Returns false if key didn't name an object.
+	constexpr bool erase(handle key) noexcept ((std::is_nothrow_move_assignable_v<T> || is_trivially_relocatable_v<T>) && std::is_nothrow_destructible_v<T>)
+	{
+		if (!contains(key))
+		{
+			return false;
+		}
+
+		const index_type position = _slots[key.index].position;
+		const index_type last = static_cast<index_type>(_values.size() - 1);
+
+		// erase_unordered moves the last object into the hole, its slot has to follow it.
+		_values.erase_unordered(_values.begin() + position);
+		_slot_of[position] = _slot_of[last];
+		_slots[_slot_of[position]].position = position;
+
+		release_slot(key.index);
+
+		return true;
+	}
+
+	// Erases the object at a position of the dense array, e.g. while iterating. The last object takes its place.
+	constexpr iterator erase(const_iterator position) noexcept ((std::is_nothrow_move_assignable_v<T> || is_trivially_relocatable_v<T>) && std::is_nothrow_destructible_v<T>)
+	{
+		const std::size_t offset = static_cast<std::size_t>(position - cbegin());
+		erase(handle_at(offset));
+		return begin() + static_cast<difference_type>(offset);
+	}
+
+	// Invalidates every handle handed out so far.
+	constexpr void clear() noexcept (std::is_nothrow_destructible_v<T>)
+	{
+		for (std::size_t position = 0; position < _values.size(); ++position)
+		{
+			release_slot(_slot_of[position]);
+		}
+		_values.clear();
+	}
+
+private:
+
+	// position is the object's place in _values while the slot is in use, and the next free slot while it isn't.
+	struct slot
+	{
+		index_type position;
+		generation_type generation;
+	};
+
+	constexpr index_type take_free_slot() noexcept
+	{
+		if (_free_head != no_slot)
+		{
+			const index_type slot = _free_head;
+			_free_head = _slots[slot].position;
+			return slot;
+		}
+
+		// Slots are only initialized the first time they are needed, so constructing the map doesn't touch them.
+		_slots[_slots_used].generation = 1;
+		return _slots_used++;
+	}
+
+	constexpr void release_slot(index_type index) noexcept
+	{
+		// Skipping 0 on wrap around keeps default constructed handles from ever resolving.
+		generation_type& generation = _slots[index].generation;
+		generation = generation == std::numeric_limits<generation_type>::max() ? 1 : generation + 1;
+
+		_slots[index].position = _free_head;
+		_free_head = index;
+	}
+
+	values_type _values;
+	std::array<slot, Capacity> _slots;
+	// The slot of each object in _values, to repoint it when the object moves.
+	std::array<index_type, Capacity> _slot_of;
+	index_type _free_head = no_slot;
+	index_type _slots_used = 0;
+};
+
+namespace static_slot_map_static_assertions
+{
+	static_assert(sizeof(static_slot_map<int, 200>::handle) == 8);
+	static_assert(std::is_trivially_copyable_v<static_slot_map<int, 32>>);
+}
@@ -0,0 +1,678 @@
+#pragma once
+
+#include "static_vector.hpp"
+
+#include <span>
+#include <tuple>
+
+// A fixed capacity vector of rows with one field of each of Ts..., stored as a structure of arrays: every field gets an inline
+// array of its own, all sharing one size. A loop reading a single field then streams through contiguous memory holding nothing else,
+// instead of striding over whole structs, and get<I>() hands that column out as a std::span ready for vectorized kernels.
+// Each column starts on a cache line, so aligned SIMD loads from the front of a column are fine too.
+//
+// Rows are accessed through std::tuple<Ts&...> proxies, which support structured bindings, std::get and assignment from a std::tuple<Ts...>.
+// Capacity and error handling follow static_vector: overflows are reported to Policy::capacity_exceeded, bad accesses to Policy::out_of_range.
+template <typename Policy, std::size_t Capacity, typename ... Ts>
+class basic_static_soa_vector
+{
+	static_assert(sizeof...(Ts) > 0, "static_soa_vector needs at least one field");
+
+	using size_field_type = static_vector_detail::size_type_for<Capacity>;
+
+	template <std::size_t I, typename T>
+	struct alignas(std::max(alignof(T), static_vector_detail::cache_line_bytes)) column
+	{
+		std::aligned_storage_t<sizeof(T), alignof(T)> slots[Capacity];
+
+		T* data() noexcept
+		{
+			return std::launder(reinterpret_cast<T*>(slots));
+		}
+
+		const T* data() const noexcept
+		{
+			return std::launder(reinterpret_cast<const T*>(slots));
+		}
+	};
+
+	// One base per field, told apart by index so that repeated field types work. Unlike a std::tuple of columns this stays trivially copyable.
+	template <std::size_t ... I>
+	struct column_set : column<I, Ts>...
+	{
+	};
+
+	template <std::size_t ... I>
+	static auto make_column_set(std::index_sequence<I...>) -> column_set<I...>;
+
+	static constexpr bool trivially_copyable = (std::is_trivially_copyable_v<Ts> && ...);
+	static constexpr bool trivially_destructible = (std::is_trivially_destructible_v<Ts> && ...);
+	static constexpr bool nothrow_destructible = (std::is_nothrow_destructible_v<Ts> && ...);
+
+	template <bool Const>
+	struct basic_iterator
+	{
+		using vector_type = std::conditional_t<Const, const basic_static_soa_vector, basic_static_soa_vector>;
+
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using iterator_concept = std::random_access_iterator_tag;
+		using difference_type = std::ptrdiff_t;
+		using value_type = std::tuple<Ts...>;
+		using reference = std::conditional_t<Const, std::tuple<const Ts&...>, std::tuple<Ts&...>>;
+
+		// operator-> has to hand out a pointer, so it points into a copy of the reference tuple.
+		struct pointer
+		{
+			reference row;
+
+			constexpr const reference* operator->() const noexcept
+			{
+				return std::addressof(row);
+			}
+		};
+
+		constexpr basic_iterator() noexcept = default;
+
+		template <bool Other_Const> requires (Const && !Other_Const)
+		constexpr basic_iterator(const basic_iterator<Other_Const>& other) noexcept
+			: _vector(other._vector), _index(other._index)
+		{
+		}
+
+		constexpr reference operator*() const noexcept
+		{
+			return _vector->row(_index);
+		}
+
+		constexpr pointer operator->() const noexcept
+		{
+			return pointer{ **this };
+		}
+
+		constexpr reference operator[](difference_type offset) const noexcept
+		{
+			return *(*this + offset);
+		}
+
+		constexpr basic_iterator& operator++() noexcept
+		{
+			++_index;
+			return *this;
+		}
+
+		constexpr basic_iterator operator++(int) noexcept
+		{
+			basic_iterator copy = *this;
+			++_index;
+			return copy;
+		}
+
+		constexpr basic_iterator& operator--() noexcept
+		{
+			--_index;
+			return *this;
+		}
+
+		constexpr basic_iterator operator--(int) noexcept
+		{
+			basic_iterator copy = *this;
+			--_index;
+			return copy;
+		}
+
+		constexpr basic_iterator& operator+=(difference_type offset) noexcept
+		{
+			_index = static_cast<std::size_t>(static_cast<difference_type>(_index) + offset);
+			return *this;
+		}
+
+		constexpr basic_iterator& operator-=(difference_type offset) noexcept
+		{
+			return *this += -offset;
+		}
+
+		constexpr friend basic_iterator operator+(basic_iterator it, difference_type offset) noexcept
+		{
+			return it += offset;
+		}
+
+		constexpr friend basic_iterator operator+(difference_type offset, basic_iterator it) noexcept
+		{
+			return it += offset;
+		}
+
+		constexpr friend basic_iterator operator-(basic_iterator it, difference_type offset) noexcept
+		{
+			return it -= offset;
+		}
+
+		constexpr friend difference_type operator-(const basic_iterator& a, const basic_iterator& b) noexcept
+		{
+			return static_cast<difference_type>(a._index) - static_cast<difference_type>(b._index);
+		}
+
+		constexpr friend bool operator==(const basic_iterator& a, const basic_iterator& b) noexcept
+		{
+			return a._index == b._index;
+		}
+
+		constexpr friend auto operator<=>(const basic_iterator& a, const basic_iterator& b) noexcept
+		{
+			return a._index <=> b._index;
+		}
+
+	private:
+		friend class basic_static_soa_vector;
+		friend struct basic_iterator<true>;
+
+		constexpr basic_iterator(vector_type* vector, std::size_t index) noexcept
+			: _vector(vector), _index(index)
+		{
+		}
+
+		vector_type* _vector = nullptr;
+		std::size_t _index = 0;
+	};
+
+public:
+
+	using value_type = std::tuple<Ts...>;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = std::tuple<Ts&...>;
+	using const_reference = std::tuple<const Ts&...>;
+	using iterator = basic_iterator<false>;
+	using const_iterator = basic_iterator<true>;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	template <std::size_t I>
+	using field_type = std::tuple_element_t<I, value_type>;
+
+	constexpr basic_static_soa_vector() noexcept = default;
+
+	constexpr basic_static_soa_vector(std::initializer_list<value_type> rows) requires ((std::is_copy_constructible_v<Ts> && ...))
+	{
+		if (rows.size() > Capacity) [[unlikely]]
+		{
+			Policy::capacity_exceeded("Static SoA vector lacks the capacity for so many rows!");
+		}
+
+		clear_guard guard{ *this };
+		for (const value_type& row : rows | std::views::take(Capacity))
+		{
+			std::apply([this](const Ts& ... fields) { unchecked_emplace_back(fields...); }, row);
+		}
+		guard.dismissed = true;
+	}
+
+	constexpr basic_static_soa_vector(const basic_static_soa_vector&) noexcept requires (trivially_copyable) = default;
+
+	constexpr basic_static_soa_vector(const basic_static_soa_vector& other) noexcept ((std::is_nothrow_copy_constructible_v<Ts> && ...))
+		requires (!trivially_copyable && (std::is_copy_constructible_v<Ts> && ...))
+	{
+		clear_guard guard{ *this };
+		for (std::size_t index = 0; index < other.size(); ++index)
+		{
+			std::apply([this](const Ts& ... fields) { unchecked_emplace_back(fields...); }, other.row(index));
+		}
+		guard.dismissed = true;
+	}
+
+	// Moving leaves the moved-from rows in other, like static_vector.
+	constexpr basic_static_soa_vector(basic_static_soa_vector&&) noexcept requires (trivially_copyable) = default;
+
+	constexpr basic_static_soa_vector(basic_static_soa_vector&& other) noexcept ((std::is_nothrow_move_constructible_v<Ts> && ...))
+		requires (!trivially_copyable && (std::is_move_constructible_v<Ts> && ...))
+	{
+		clear_guard guard{ *this };
+		for (std::size_t index = 0; index < other.size(); ++index)
+		{
+			std::apply([this](Ts& ... fields) { unchecked_emplace_back(std::move(fields)...); }, other.row(index));
+		}
+		guard.dismissed = true;
+	}
+
+	constexpr basic_static_soa_vector& operator=(const basic_static_soa_vector&) noexcept requires (trivially_copyable) = default;
+
+	constexpr basic_static_soa_vector& operator=(const basic_static_soa_vector& other) noexcept ((std::is_nothrow_copy_constructible_v<Ts> && ...) && nothrow_destructible)
+		requires (!trivially_copyable && (std::is_copy_constructible_v<Ts> && ...))
+	{
+		if (this != &other)
+		{
+			clear();
+			for (std::size_t index = 0; index < other.size(); ++index)
+			{
+				std::apply([this](const Ts& ... fields) { unchecked_emplace_back(fields...); }, other.row(index));
+			}
+		}
+		return *this;
+	}
+
+	constexpr basic_static_soa_vector& operator=(basic_static_soa_vector&&) noexcept requires (trivially_copyable) = default;
+
+	constexpr basic_static_soa_vector& operator=(basic_static_soa_vector&& other) noexcept ((std::is_nothrow_move_constructible_v<Ts> && ...) && nothrow_destructible)
+		requires (!trivially_copyable && (std::is_move_constructible_v<Ts> && ...))
+	{
+		if (this != &other)
+		{
+			clear();
+			for (std::size_t index = 0; index < other.size(); ++index)
+			{
+				std::apply([this](Ts& ... fields) { unchecked_emplace_back(std::move(fields)...); }, other.row(index));
+			}
+		}
+		return *this;
+	}
+
+	constexpr ~basic_static_soa_vector() noexcept requires (trivially_destructible) = default;
+	constexpr ~basic_static_soa_vector() noexcept (nothrow_destructible) requires (!trivially_destructible)
+	{
+		clear();
+	}
+
+	constexpr std::size_t size() const noexcept
+	{
+		return _size;
+	}
+
+	constexpr bool empty() const noexcept
+	{
+		return _size == 0;
+	}
+
+	consteval std::size_t max_size() const noexcept
+	{
+		return Capacity;
+	}
+
+	consteval std::size_t capacity() const noexcept
+	{
+		return Capacity;
+	}
+
+	constexpr std::size_t free_space() const noexcept
+	{
+		return Capacity - _size;
+	}
+
+	// Field I of every row, contiguous and in row order.
+	template <std::size_t I>
+	constexpr std::span<field_type<I>> get() noexcept
+	{
+		return std::span<field_type<I>>(data<I>(), _size);
+	}
+
+	template <std::size_t I>
+	constexpr std::span<const field_type<I>> get() const noexcept
+	{
+		return std::span<const field_type<I>>(data<I>(), _size);
+	}
+
+	// The start of column I, aligned to at least a cache line.
+	template <std::size_t I>
+	constexpr field_type<I>* data() noexcept
+	{
+		return static_cast<column<I, field_type<I>>&>(_columns).data();
+	}
+
+	template <std::size_t I>
+	constexpr const field_type<I>* data() const noexcept
+	{
+		return static_cast<const column<I, field_type<I>>&>(_columns).data();
+	}
+
+	constexpr iterator begin() noexcept
+	{
+		return iterator(this, 0);
+	}
+
+	constexpr const_iterator begin() const noexcept
+	{
+		return const_iterator(this, 0);
+	}
+
+	constexpr iterator end() noexcept
+	{
+		return iterator(this, _size);
+	}
+
+	constexpr const_iterator end() const noexcept
+	{
+		return const_iterator(this, _size);
+	}
+
+	constexpr const_iterator cbegin() const noexcept
+	{
+		return begin();
+	}
+
+	constexpr const_iterator cend() const noexcept
+	{
+		return end();
+	}
+
+	constexpr reverse_iterator rbegin() noexcept
+	{
+		return reverse_iterator(end());
+	}
+
+	constexpr const_reverse_iterator rbegin() const noexcept
+	{
+		return const_reverse_iterator(end());
+	}
+
+	constexpr reverse_iterator rend() noexcept
+	{
+		return reverse_iterator(begin());
+	}
+
+	constexpr const_reverse_iterator rend() const noexcept
+	{
+		return const_reverse_iterator(begin());
+	}
+
+	constexpr reference operator[](std::size_t index) noexcept (!Policy::checks_indexing || Policy::is_nothrow)
+	{
+		if constexpr (Policy::checks_indexing)
+		{
+			if (index >= _size) [[unlikely]]
+			{
+				Policy::out_of_range("Index out of bounds!");
+			}
+		}
+		return row(index);
+	}
+
+	constexpr const_reference operator[](std::size_t index) const noexcept (!Policy::checks_indexing || Policy::is_nothrow)
+	{
+		if constexpr (Policy::checks_indexing)
+		{
+			if (index >= _size) [[unlikely]]
+			{
+				Policy::out_of_range("Index out of bounds!");
+			}
+		}
+		return row(index);
+	}
+
+	constexpr reference at(std::size_t index) noexcept (Policy::is_nothrow)
+	{
+		if (index >= _size) [[unlikely]]
+		{
+			Policy::out_of_range("Index out of bounds!");
+		}
+		return row(index);
+	}
+
+	constexpr const_reference at(std::size_t index) const noexcept (Policy::is_nothrow)
+	{
+		if (index >= _size) [[unlikely]]
+		{
+			Policy::out_of_range("Index out of bounds!");
+		}
+		return row(index);
+	}
+
+	constexpr reference front() noexcept
+	{
+		return row(0);
+	}
+
+	constexpr const_reference front() const noexcept
+	{
+		return row(0);
+	}
+
+	constexpr reference back() noexcept
+	{
+		return row(_size - 1);
+	}
+
+	constexpr const_reference back() const noexcept
+	{
+		return row(_size - 1);
+	}
+
+	constexpr void push_back(const Ts& ... fields) noexcept ((std::is_nothrow_copy_constructible_v<Ts> && ...) && Policy::is_nothrow)
+	{
+		emplace_back(fields...);
+	}
+
+	constexpr void push_back(Ts&& ... fields) noexcept ((std::is_nothrow_move_constructible_v<Ts> && ...) && Policy::is_nothrow)
+	{
+		emplace_back(std::move(fields)...);
+	}
+
+	// Constructs every field of a new row from one argument each. On overflow the row is dropped if Policy returns.
+	template <typename ... Args> requires (sizeof...(Args) == sizeof...(Ts) && (std::is_constructible_v<Ts, Args> && ...))
+	constexpr void emplace_back(Args&& ... args) noexcept ((std::is_nothrow_constructible_v<Ts, Args> && ...) && Policy::is_nothrow)
+	{
+		if (_size == Capacity) [[unlikely]]
+		{
+			Policy::capacity_exceeded("Static SoA vector is at full capacity, push back not allowed!");
+			return;
+		}
+
+		unchecked_emplace_back(std::forward<Args>(args)...);
+	}
+
+	// Returns false instead of reporting an overflow.
+	template <typename ... Args> requires (sizeof...(Args) == sizeof...(Ts) && (std::is_constructible_v<Ts, Args> && ...))
+	constexpr bool try_emplace_back(Args&& ... args) noexcept ((std::is_nothrow_constructible_v<Ts, Args> && ...))
+	{
+		if (_size == Capacity)
+		{
+			return false;
+		}
+
+		unchecked_emplace_back(std::forward<Args>(args)...);
+		return true;
+	}
+
+	// Appends a row without checking the capacity, the caller must make sure that size() < capacity().
+	template <typename ... Args> requires (sizeof...(Args) == sizeof...(Ts) && (std::is_constructible_v<Ts, Args> && ...))
+	constexpr reference unchecked_emplace_back(Args&& ... args) noexcept ((std::is_nothrow_constructible_v<Ts, Args> && ...))
+	{
+		static_vector_detail::debug_check(_size < Capacity, "unchecked_emplace_back on a full static_soa_vector");
+
+		construct_row(_size, std::forward<Args>(args)...);
+		_size++;
+
+		return row(_size - 1);
+	}
+
+	constexpr void pop_back() noexcept (nothrow_destructible && Policy::is_nothrow)
+	{
+		if (empty()) [[unlikely]]
+		{
+			Policy::out_of_range("Can't pop from empty vector!");
+		}
+
+		truncate(_size - 1u);
+	}
+
+	constexpr void pop_back(std::size_t count) noexcept (nothrow_destructible && Policy::is_nothrow)
+	{
+		if (count > _size) [[unlikely]]
+		{
+			Policy::out_of_range("Can't pop more elements than the vector holds!");
+		}
+
+		truncate(_size - count);
+	}
+
+	// Shrinks the vector to its first count rows, does nothing if it isn't larger than that.
+	constexpr void truncate(std::size_t count) noexcept (nothrow_destructible)
+	{
+		if (count < _size)
+		{
+			if constexpr (!trivially_destructible)
+			{
+				for_each_column([&](auto* column)
+				{
+					std::destroy(column + count, column + _size);
+				});
+			}
+
+			_size = static_cast<size_field_type>(count);
+		}
+	}
+
+	constexpr void clear() noexcept (nothrow_destructible)
+	{
+		truncate(0);
+	}
+
+	// Value initializes the added rows.
+	constexpr void resize(std::size_t new_size) requires ((std::is_default_constructible_v<Ts> && ...))
+	{
+		if (new_size > Capacity) [[unlikely]]
+		{
+			Policy::capacity_exceeded("Can't resize beyond capacity!");
+			new_size = Capacity;
+		}
+
+		truncate(new_size);
+		while (_size < new_size)
+		{
+			unchecked_emplace_back(Ts()...);
+		}
+	}
+
+	// Shifts the following rows down in every column.
+	constexpr iterator erase(const_iterator position) noexcept ((std::is_nothrow_move_assignable_v<Ts> && ...) && nothrow_destructible)
+	{
+		const std::size_t index = position._index;
+
+		for_each_column([&](auto* column)
+		{
+			std::move(column + index + 1, column + _size, column + index);
+		});
+		truncate(_size - 1u);
+
+		return iterator(this, index);
+	}
+
+	// Moves the last row into the erased one, O(1) but doesn't keep the order.
+	constexpr iterator erase_unordered(const_iterator position) noexcept ((std::is_nothrow_move_assignable_v<Ts> && ...) && nothrow_destructible)
+	{
+		const std::size_t index = position._index;
+
+		if (index != _size - 1u)
+		{
+			for_each_column([&](auto* column)
+			{
+				column[index] = std::move(column[_size - 1u]);
+			});
+		}
+		truncate(_size - 1u);
+
+		return iterator(this, index);
+	}
+
+	constexpr friend bool operator==(const basic_static_soa_vector& lhs, const basic_static_soa_vector& rhs) requires ((std::equality_comparable<Ts> && ...))
+	{
+		return lhs.size() == rhs.size() && [&]<std::size_t ... I>(std::index_sequence<I...>)
+		{
+			return (std::ranges::equal(lhs.template get<I>(), rhs.template get<I>()) && ...);
+		}(std::index_sequence_for<Ts...>());
+	}
+
+private:
+
+	// Empties the vector unless dismissed, so that a constructor throwing halfway through doesn't leak the rows built so far.
+	struct clear_guard
+	{
+		basic_static_soa_vector& vector;
+		bool dismissed = false;
+
+		constexpr ~clear_guard()
+		{
+			if (!dismissed)
+			{
+				vector.clear();
+			}
+		}
+	};
+
+	// Destroys the first constructed fields of a row unless dismissed.
+	struct row_guard
+	{
+		basic_static_soa_vector& vector;
+		std::size_t index;
+		std::size_t constructed = 0;
+		bool dismissed = false;
+
+		constexpr ~row_guard()
+		{
+			if (!dismissed)
+			{
+				[&]<std::size_t ... I>(std::index_sequence<I...>)
+				{
+					((I < constructed ? std::destroy_at(vector.template data<I>() + index) : void()), ...);
+				}(std::index_sequence_for<Ts...>());
+			}
+		}
+	};
+
+	template <typename Function>
+	constexpr void for_each_column(Function function)
+	{
+		[&]<std::size_t ... I>(std::index_sequence<I...>)
+		{
+			(function(data<I>()), ...);
+		}(std::index_sequence_for<Ts...>());
+	}
+
+	constexpr reference row(std::size_t index) noexcept
+	{
+		return [&]<std::size_t ... I>(std::index_sequence<I...>)
+		{
+			return reference(data<I>()[index]...);
+		}(std::index_sequence_for<Ts...>());
+	}
+
+	constexpr const_reference row(std::size_t index) const noexcept
+	{
+		return [&]<std::size_t ... I>(std::index_sequence<I...>)
+		{
+			return const_reference(data<I>()[index]...);
+		}(std::index_sequence_for<Ts...>());
+	}
+
+	template <typename ... Args>
+	constexpr void construct_row(std::size_t index, Args&& ... args) noexcept ((std::is_nothrow_constructible_v<Ts, Args> && ...))
+	{
+		[&]<std::size_t ... I>(std::index_sequence<I...>)
+		{
+			if constexpr ((std::is_nothrow_constructible_v<Ts, Args> && ...))
+			{
+				(std::construct_at(data<I>() + index, std::forward<Args>(args)), ...);
+			}
+			else
+			{
+				row_guard guard{ *this, index };
+				((std::construct_at(data<I>() + index, std::forward<Args>(args)), ++guard.constructed), ...);
+				guard.dismissed = true;
+			}
+		}(std::index_sequence_for<Ts...>());
+	}
+
+	decltype(make_column_set(std::index_sequence_for<Ts...>())) _columns;
+	size_field_type _size = 0;
+};
+
+template <std::size_t Capacity, typename ... Ts>
+using static_soa_vector = basic_static_soa_vector<static_vector_default_policy, Capacity, Ts...>;
+
+namespace static_soa_vector_static_assertions
+{
+	// Every column starts on a cache line of its own.
+	static_assert(alignof(static_soa_vector<4, float, std::uint8_t>) == static_vector_detail::cache_line_bytes);
+	static_assert(sizeof(static_soa_vector<16, float, std::uint8_t>) == 3 * static_vector_detail::cache_line_bytes);
+
+	static_assert(std::is_trivially_copyable_v<static_soa_vector<8, int, float>>);
+	static_assert(!std::is_trivially_copyable_v<static_soa_vector<8, int, std::string>>);
+	static_assert(std::is_same_v<static_soa_vector<8, int, float>::reference, std::tuple<int&, float&>>);
+}
@@ -0,0 +1,272 @@
+#pragma once
+
+#include "static_vector.hpp"
+
+#include <atomic>
+#include <optional>
+#include <span>
+
+// A wait free single producer, single consumer FIFO over static_vector's uninitialized inline storage: no allocation, bounded memory.
+// Exactly one thread may call the producer functions (try_push, try_emplace, push_n) and exactly one the consumer functions
+// (try_pop, front, pop, pop_n, consume_n) at any time; size_approx() and empty() may be called from either.
+//
+// Head and tail are free running counters, each on its own cache line together with a cached copy of the other side's counter.
+// A side only reloads the other's counter (a cache line transfer) when its cached copy says the queue is full or empty,
+// and the batch operations publish a whole batch at once.
+template <typename T, std::size_t Capacity>
+class static_spsc_queue
+{
+	static_assert(Capacity > 0, "static_spsc_queue needs room for at least one element");
+
+	static constexpr std::size_t cache_line = static_vector_detail::cache_line_bytes;
+
+public:
+
+	using value_type = T;
+	using size_type = std::size_t;
+	using reference = value_type&;
+	using const_reference = const value_type&;
+
+	constexpr static_spsc_queue() noexcept = default;
+
+	// The queue is shared by two threads by address, copying or moving it can't be made meaningful.
+	static_spsc_queue(const static_spsc_queue&) = delete;
+	static_spsc_queue& operator=(const static_spsc_queue&) = delete;
+
+	~static_spsc_queue()
+	{
+		if constexpr (!std::is_trivially_destructible_v<T>)
+		{
+			const std::size_t tail = _tail.load(std::memory_order_acquire);
+			for (std::size_t head = _head.load(std::memory_order_relaxed); head != tail; ++head)
+			{
+				std::destroy_at(slot(head));
+			}
+		}
+	}
+
+	static consteval std::size_t capacity() noexcept
+	{
+		return Capacity;
+	}
+
+	// Only a snapshot, the other thread may change it right away.
+	std::size_t size_approx() const noexcept
+	{
+		const std::size_t head = _head.load(std::memory_order_acquire);
+		const std::size_t tail = _tail.load(std::memory_order_acquire);
+		return tail - head;
+	}
+
+	bool empty() const noexcept
+	{
+		return size_approx() == 0;
+	}
+
+	// Producer: constructs an element at the back, returns false if the queue is full.
+	template <typename ... Args>
+	bool try_emplace(Args&& ... args) noexcept (std::is_nothrow_constructible_v<T, Args...>)
+	{
+		const std::size_t tail = _tail.load(std::memory_order_relaxed);
+
+		if (tail - _cached_head == Capacity)
+		{
+			_cached_head = _head.load(std::memory_order_acquire);
+			if (tail - _cached_head == Capacity)
+			{
+				return false;
+			}
+		}
+
+		std::construct_at(slot(tail), std::forward<Args>(args)...);
+		_tail.store(tail + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	bool try_push(const T& value) noexcept (std::is_nothrow_copy_constructible_v<T>)
+	{
+		return try_emplace(value);
+	}
+
+	bool try_push(T&& value) noexcept (std::is_nothrow_move_constructible_v<T>)
+	{
+		return try_emplace(std::move(value));
+	}
+
+	// Producer: constructs up to count elements from first, which land in at most two contiguous runs of the buffer, and publishes them at once.
+	// Returns how many were pushed, which is less than count if the queue filled up.
+	template <typename Iterator> requires (std::input_iterator<Iterator> && std::constructible_from<T, std::iter_reference_t<Iterator>>)
+	std::size_t push_n(Iterator first, std::size_t count) noexcept (std::is_nothrow_constructible_v<T, std::iter_reference_t<Iterator>>)
+	{
+		const std::size_t tail = _tail.load(std::memory_order_relaxed);
+
+		if (Capacity - (tail - _cached_head) < count)
+		{
+			_cached_head = _head.load(std::memory_order_acquire);
+		}
+
+		count = std::min(count, Capacity - (tail - _cached_head));
+
+		const std::size_t index = wrap(tail);
+		const std::size_t first_run = std::min(count, Capacity - index);
+
+		// The first run is published on its own when the batch wraps, so that a constructor throwing in the second one can't leave it orphaned.
+		first = std::ranges::uninitialized_copy_n(first, first_run, data() + index, data() + index + first_run).in;
+		if (count != first_run)
+		{
+			_tail.store(tail + first_run, std::memory_order_release);
+			std::ranges::uninitialized_copy_n(first, count - first_run, data(), data() + (count - first_run));
+		}
+
+		_tail.store(tail + count, std::memory_order_release);
+
+		return count;
+	}
+
+	std::size_t push_n(std::span<const T> values) noexcept (std::is_nothrow_copy_constructible_v<T>)
+	{
+		return push_n(values.begin(), values.size());
+	}
+
+	// Consumer: the front element, or nullptr if the queue is empty. It stays valid until it is popped.
+	T* front() noexcept
+	{
+		const std::size_t head = _head.load(std::memory_order_relaxed);
+
+		if (head == _cached_tail)
+		{
+			_cached_tail = _tail.load(std::memory_order_acquire);
+			if (head == _cached_tail)
+			{
+				return nullptr;
+			}
+		}
+
+		return slot(head);
+	}
+
+	// Consumer: removes the front element, which front() must have returned.
+	void pop() noexcept (std::is_nothrow_destructible_v<T>)
+	{
+		const std::size_t head = _head.load(std::memory_order_relaxed);
+		static_vector_detail::debug_check(head != _cached_tail, "pop on an empty static_spsc_queue");
+
+		std::destroy_at(slot(head));
+		_head.store(head + 1, std::memory_order_release);
+	}
+
+	// Consumer: moves the front element into value, returns false if the queue is empty.
+	bool try_pop(T& value) noexcept (std::is_nothrow_move_assignable_v<T> && std::is_nothrow_destructible_v<T>)
+	{
+		T* const element = front();
+		if (element == nullptr)
+		{
+			return false;
+		}
+
+		value = std::move(*element);
+		pop();
+
+		return true;
+	}
+
+	std::optional<T> try_pop() noexcept (std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>)
+	{
+		T* const element = front();
+		if (element == nullptr)
+		{
+			return std::nullopt;
+		}
+
+		std::optional<T> value(std::move(*element));
+		pop();
+
+		return value;
+	}
+
+	// Consumer: hands up to max_count front elements to function in place, as one or two std::span<T> calls in FIFO order,
+	// then destroys them and releases their slots with a single store. Returns how many elements were consumed.
+	template <typename Function> requires (std::invocable<Function&, std::span<T>>)
+	std::size_t consume_n(std::size_t max_count, Function function)
+	{
+		const std::size_t head = _head.load(std::memory_order_relaxed);
+
+		if (_cached_tail - head < max_count)
+		{
+			_cached_tail = _tail.load(std::memory_order_acquire);
+		}
+
+		const std::size_t count = std::min(max_count, _cached_tail - head);
+		if (count == 0)
+		{
+			return 0;
+		}
+
+		const std::size_t index = wrap(head);
+		const std::size_t first_run = std::min(count, Capacity - index);
+
+		function(std::span<T>(data() + index, first_run));
+		if (count != first_run)
+		{
+			function(std::span<T>(data(), count - first_run));
+		}
+
+		if constexpr (!std::is_trivially_destructible_v<T>)
+		{
+			std::destroy_n(data() + index, first_run);
+			std::destroy_n(data(), count - first_run);
+		}
+
+		_head.store(head + count, std::memory_order_release);
+
+		return count;
+	}
+
+	// Consumer: moves up to out.size() front elements into out, returns how many.
+	std::size_t pop_n(std::span<T> out) noexcept (std::is_nothrow_move_assignable_v<T> && std::is_nothrow_destructible_v<T>)
+	{
+		auto destination = out.begin();
+
+		return consume_n(out.size(), [&](std::span<T> run)
+		{
+			destination = std::move(run.begin(), run.end(), destination);
+		});
+	}
+
+private:
+
+	static constexpr std::size_t wrap(std::size_t counter) noexcept
+	{
+		// Capacity is a compile time constant, so for a power of two this is a mask and otherwise a multiplication.
+		return counter % Capacity;
+	}
+
+	T* data() noexcept
+	{
+		return std::launder(reinterpret_cast<T*>(_data));
+	}
+
+	T* slot(std::size_t counter) noexcept
+	{
+		return data() + wrap(counter);
+	}
+
+	// Written by the producer. _cached_head is the producer's last view of _head.
+	alignas(cache_line) std::atomic<std::size_t> _tail = 0;
+	std::size_t _cached_head = 0;
+
+	// Written by the consumer. _cached_tail is the consumer's last view of _tail.
+	alignas(cache_line) std::atomic<std::size_t> _head = 0;
+	std::size_t _cached_tail = 0;
+
+	// Starts on its own line, so the first elements don't share one with the consumer's indices.
+	alignas(cache_line) std::aligned_storage_t<sizeof(T), alignof(T)> _data[Capacity];
+};
+
+namespace static_spsc_queue_static_assertions
+{
+	// Producer indices, consumer indices and the elements each start a cache line of their own.
+	static_assert(sizeof(static_spsc_queue<std::uint64_t, 8>) == 2 * static_vector_detail::cache_line_bytes + 8 * sizeof(std::uint64_t));
+	static_assert(alignof(static_spsc_queue<char, 1>) == static_vector_detail::cache_line_bytes);
+}
@@ -5,6 +5,23 @@
 #include <utility>
 #include <algorithm>
 #include <new>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <iterator>
+#include <ranges>
+#include <initializer_list>
+#include <stdexcept>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <string>
+#include <vector>
+#include <bit>
+#include <functional>
+#include <span>
+#include <atomic>
 
 #ifdef _DEBUG
 	constexpr static bool STATIC_VECTOR_DEBUGGING = true;
@@ -12,269 +29,916 @@
 	constexpr static bool STATIC_VECTOR_DEBUGGING = false;
 #endif // _DEBUG
 
-template <typename T, size_t Capacity>
-class static_vector;
+#if defined(__cpp_exceptions) || defined(_CPPUNWIND)
+	#define STATIC_VECTOR_HAS_EXCEPTIONS 1
+#else
+	#define STATIC_VECTOR_HAS_EXCEPTIONS 0
+#endif
+
+// Searches over arithmetic elements use SSE2, and AVX2 when the CPU has it, on x86. Define STATIC_VECTOR_NO_SIMD to always use the scalar loops.
+#if !defined(STATIC_VECTOR_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+	#define STATIC_VECTOR_HAS_SIMD 1
+	#include <immintrin.h>
+	#if defined(_MSC_VER) && !defined(__clang__)
+		#include <intrin.h>
+		#define STATIC_VECTOR_TARGET_AVX2
+	#else
+		#define STATIC_VECTOR_TARGET_AVX2 __attribute__((target("avx2")))
+	#endif
+#else
+	#define STATIC_VECTOR_HAS_SIMD 0
+#endif
+
+// Bulk operations also come in overloads taking a standard execution policy, e.g. std::execution::par, to spread the work over threads.
+// They need <execution>, which libstdc++ backs with TBB whenever TBB's headers are installed, so that programs including it have to link
+// with -ltbb. They are therefore only enabled by default with MSVC, define STATIC_VECTOR_HAS_EXECUTION to 1 to use them elsewhere.
+#ifndef STATIC_VECTOR_HAS_EXECUTION
+	#if defined(_MSC_VER)
+		#define STATIC_VECTOR_HAS_EXECUTION 1
+	#else
+		#define STATIC_VECTOR_HAS_EXECUTION 0
+	#endif
+#endif
+
+#if STATIC_VECTOR_HAS_EXECUTION
+	#include <execution>
+#endif
+
+// Below this many bytes of elements, the execution policy overloads run the sequential code instead, as starting threads would cost more
+// than they save. The default of a megabyte is on the safe side, bench/parallel_bulk_benchmark.cpp shows where the crossover is on a
+// given machine.
+#ifndef STATIC_VECTOR_PARALLEL_MIN_BYTES
+	#define STATIC_VECTOR_PARALLEL_MIN_BYTES (std::size_t{ 1 } << 20)
+#endif
+
+// Error policies decide what a static_vector does when an operation would exceed its capacity or access an element that isn't there.
+// A policy is a type providing:
+//  - static void capacity_exceeded(const char* message), called before an operation that would overflow. Should it return,
+//    the operation goes on with as many elements as still fit: single element insertions are dropped and bulk ones truncated.
+//  - [[noreturn]] static void out_of_range(const char* message), called by at(), by a checked operator[] and by pop_back() on an empty vector.
+//  - static constexpr bool is_nothrow, true if neither function throws.
+//  - static constexpr bool checks_indexing, true if operator[] should validate its index.
+//  - optionally static constexpr bool copies_live_prefix, see static_vector_copy_mode.
+//  - optionally template <typename T, std::size_t Capacity> class instrumentation, see static_vector_instrumentation.hpp.
+//  - optionally static constexpr std::size_t element_alignment and static constexpr bool pads_to_cache_line, see static_vector_alignment.
+// All checks are marked [[unlikely]], so the policy calls stay out of the hot path.
+
+#if STATIC_VECTOR_HAS_EXCEPTIONS
+// Throws std::runtime_error on overflow and std::out_of_range on bad accesses.
+struct static_vector_throw_policy
+{
+	static constexpr bool is_nothrow = false;
+	static constexpr bool checks_indexing = STATIC_VECTOR_DEBUGGING;
 
-template<typename T, std::size_t Capacity> 
-constexpr void swap(static_vector<T, Capacity>& lhs, static_vector<T, Capacity>& rhs) noexcept (std::is_nothrow_swappable_v<T> && (std::is_move_constructible_v<T> || std::is_copy_constructible_v<T>));
+	[[noreturn]] static void capacity_exceeded(const char* message)
+	{
+		throw std::runtime_error(message);
+	}
+
+	[[noreturn]] static void out_of_range(const char* message)
+	{
+		throw std::out_of_range(message);
+	}
+};
+#endif
 
-template <typename T, size_t Capacity>
-class static_vector
+// Calls std::terminate on any error, usable with exceptions disabled.
+struct static_vector_terminate_policy
 {
-	// std::aligned_storage_t will hold the stack memory for our objects but won't actually initialize them
-	std::aligned_storage_t<sizeof(T), alignof(T)> _data[Capacity]{};
-	std::size_t _size = 0;
+	static constexpr bool is_nothrow = true;
+	static constexpr bool checks_indexing = STATIC_VECTOR_DEBUGGING;
 
-public:
+	[[noreturn]] static void capacity_exceeded(const char*) noexcept
+	{
+		std::terminate();
+	}
 
-	template<typename U, std::size_t Other_Size>
-	friend class static_vector;
+	[[noreturn]] static void out_of_range(const char*) noexcept
+	{
+		std::terminate();
+	}
+};
 
-	friend constexpr void swap<>(static_vector& lhs, static_vector& rhs) noexcept (std::is_nothrow_swappable_v<T> && (std::is_move_constructible_v<T> || std::is_copy_constructible_v<T>));
+// Hands every error to Handler (a function taking the error message), e.g. to log it or to throw a custom exception.
+// Execution never continues past a failed check, the program is terminated if Handler returns.
+template <auto Handler> requires (std::is_invocable_v<decltype(Handler), const char*>)
+struct static_vector_callback_policy
+{
+	static constexpr bool is_nothrow = std::is_nothrow_invocable_v<decltype(Handler), const char*>;
+	static constexpr bool checks_indexing = STATIC_VECTOR_DEBUGGING;
 
-	struct const_iterator;
-	struct iterator
+	[[noreturn]] static void capacity_exceeded(const char* message) noexcept(is_nothrow)
 	{
-		using difference_type = ptrdiff_t;
-		using value_type = T;
-		using element_type = T;
-		using pointer = T*;
-		using reference = T&;
-		using iterator_category = std::contiguous_iterator_tag;
+		Handler(message);
+		std::terminate();
+	}
 
-		friend struct const_iterator;
+	[[noreturn]] static void out_of_range(const char* message) noexcept(is_nothrow)
+	{
+		Handler(message);
+		std::terminate();
+	}
+};
 
-		constexpr iterator() noexcept : ptr{} {};
-		constexpr iterator(const iterator&) noexcept = default;
-		constexpr iterator(iterator&&) noexcept = default;
-		constexpr iterator(pointer other) noexcept : ptr{ other } {}
-		constexpr iterator(bool) = delete;
+// Silently drops whatever doesn't fit, e.g. for bounded logs that keep the first Capacity entries. Bad accesses still terminate.
+struct static_vector_saturate_policy
+{
+	static constexpr bool is_nothrow = true;
+	static constexpr bool checks_indexing = STATIC_VECTOR_DEBUGGING;
 
-		constexpr iterator& operator=(const iterator&) = default;
+	static constexpr void capacity_exceeded(const char*) noexcept
+	{
+	}
 
-		constexpr iterator& operator=(iterator&&) = default;
+	[[noreturn]] static void out_of_range(const char*) noexcept
+	{
+		std::terminate();
+	}
+};
 
-		constexpr reference operator* () const noexcept
-		{
-			return *ptr;
-		}
+#if STATIC_VECTOR_HAS_EXCEPTIONS
+using static_vector_default_policy = static_vector_throw_policy;
+#else
+using static_vector_default_policy = static_vector_terminate_policy;
+#endif
+
+// A static_vector of trivially copyable elements is itself trivially copyable: copies and moves copy the whole buffer, a fixed size
+// memcpy that beats anything looking at the size while the buffer is small. Past STATIC_VECTOR_LIVE_PREFIX_COPY_BYTES bytes of elements
+// they only copy the size() live elements instead, which makes static_vector non trivially copyable. The default is where
+// bench/copy_crossover_benchmark.cpp has the two break even for a vector a quarter full: from 512 bytes on the live elements are
+// copied faster, and a full vector costs about the same either way.
+#ifndef STATIC_VECTOR_LIVE_PREFIX_COPY_BYTES
+	#define STATIC_VECTOR_LIVE_PREFIX_COPY_BYTES 256
+#endif
+
+// Wraps Policy to choose how copies are made regardless of the threshold, e.g. static_vector_copy_mode<false> where the vector
+// has to stay trivially copyable to be memcpy-ed around or passed to C code.
+template <bool Live_Prefix, typename Policy = static_vector_default_policy>
+struct static_vector_copy_mode : Policy
+{
+	static constexpr bool copies_live_prefix = Live_Prefix;
+};
 
-		constexpr pointer operator-> () const noexcept
-		{
-			return ptr;
-		}
+// Wraps Policy to align the element buffer to Alignment bytes (or alignof(T) if that is stricter), e.g. 32 or 64 for aligned AVX
+// and AVX-512 loads; data() then tells the compiler about it through std::assume_aligned. With Pad_To_Cache_Line the whole vector
+// is also at least cache line aligned, so its size is a multiple of the cache line and vectors next to each other, e.g. one per
+// thread in an array, never share a line. An alignment of a cache line or more implies the padding.
+template <std::size_t Alignment, bool Pad_To_Cache_Line = false, typename Policy = static_vector_default_policy>
+struct static_vector_alignment : Policy
+{
+	static_assert(std::has_single_bit(Alignment), "alignments are powers of two");
 
-		constexpr iterator& operator++ () noexcept
-		{
-			++ptr;
-			return *this;
-		}
+	static constexpr std::size_t element_alignment = Alignment;
+	static constexpr bool pads_to_cache_line = Pad_To_Cache_Line;
+};
 
-		constexpr iterator operator++(int) noexcept
+template <typename T, size_t Capacity, typename Policy = static_vector_default_policy>
+class static_vector;
+
+template <typename T, std::size_t N, typename Allocator>
+class small_vector;
+
+// A type is trivially relocatable if moving an object to a new address and abandoning the old one (without running its destructor)
+// is equivalent to a plain copy of its bytes. static_vector uses this to shift, swap and move elements with memmove.
+// Trivially copyable types qualify by default, specialize this for your own types (handles, pimpl wrappers...) to opt them in.
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+// std::unique_ptr with the default deleter is just an owning pointer.
+template <typename T>
+struct is_trivially_relocatable<std::unique_ptr<T>> : std::true_type {};
+
+template <typename T>
+constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+namespace static_vector_detail
+{
+	// Checks a precondition of an operation that otherwise trusts its caller, e.g. the unchecked_ ones. Like the policies' checks_indexing
+	// it follows STATIC_VECTOR_DEBUGGING rather than NDEBUG, so one switch turns all debug validation on. A violated precondition prints
+	// message and aborts, or fails the evaluation of a constant expression.
+	constexpr void debug_check(bool condition, const char* message) noexcept
+	{
+		if constexpr (STATIC_VECTOR_DEBUGGING)
 		{
-			return iterator(ptr++);
+			if (!condition) [[unlikely]]
+			{
+				std::fprintf(stderr, "%s\n", message);
+				std::abort();
+			}
 		}
+	}
 
-		constexpr iterator& operator-- () noexcept
+	// The smallest unsigned type able to count up to Capacity, used for the stored size so that small vectors don't pay for a full std::size_t.
+	template <std::size_t Capacity>
+	using size_type_for = std::conditional_t<Capacity <= std::numeric_limits<std::uint8_t>::max(), std::uint8_t,
+		std::conditional_t<Capacity <= std::numeric_limits<std::uint16_t>::max(), std::uint16_t,
+		std::conditional_t<Capacity <= std::numeric_limits<std::uint32_t>::max(), std::uint32_t, std::size_t>>>;
+
+	constexpr std::size_t size_type_bytes(std::size_t capacity) noexcept
+	{
+		if (capacity <= std::numeric_limits<std::uint8_t>::max())
+			return sizeof(std::uint8_t);
+		if (capacity <= std::numeric_limits<std::uint16_t>::max())
+			return sizeof(std::uint16_t);
+		if (capacity <= std::numeric_limits<std::uint32_t>::max())
+			return sizeof(std::uint32_t);
+		return sizeof(std::size_t);
+	}
+
+	// Relocates count objects from source to destination, the two ranges may overlap.
+	// The objects in source are gone afterwards and their destructors must not be called.
+	template <typename T>
+	constexpr void relocate_n(T* source, std::size_t count, T* destination) noexcept
+	{
+		if (std::is_constant_evaluated())
 		{
-			--ptr;
-			return *this;
+			// No memmove in constant expressions, the objects are moved one by one. Pointers into different objects can't be ordered
+			// there either, so a destination overlapping the back of the source, which has to be walked backwards, is searched for.
+			bool backwards = false;
+			for (std::size_t i = 1; i < count && !backwards; ++i)
+			{
+				backwards = source + i == destination;
+			}
+
+			for (std::size_t step = 0; step < count; ++step)
+			{
+				const std::size_t i = backwards ? count - 1 - step : step;
+				std::construct_at(destination + i, std::move(source[i]));
+				std::destroy_at(source + i);
+			}
+			return;
 		}
 
-		constexpr iterator operator--(int) noexcept
+		if (count != 0)
 		{
-			return iterator(ptr--);
+			std::memmove(static_cast<void*>(destination), static_cast<const void*>(source), count * sizeof(T));
 		}
+	}
 
-		constexpr iterator& operator+=(const ptrdiff_t offset) noexcept
+	// The std::uninitialized_ algorithms only become constexpr in C++26. These call them, except during constant evaluation where they
+	// construct the elements one by one; a constructor throwing there fails the whole evaluation, so there is nothing to clean up.
+	template <typename Iterator, typename Output>
+	constexpr Output uninitialized_copy_n(Iterator first, std::size_t count, Output destination)
+	{
+		if (std::is_constant_evaluated())
 		{
-			ptr += offset;
-			return *this;
+			for (; count != 0; --count, ++first, ++destination)
+			{
+				std::construct_at(std::to_address(destination), *first);
+			}
+			return destination;
 		}
+		return std::uninitialized_copy_n(first, count, destination);
+	}
 
-		constexpr iterator& operator-=(const ptrdiff_t offset) noexcept
+	template <typename Iterator, typename Output>
+	constexpr Output uninitialized_move_n(Iterator first, std::size_t count, Output destination)
+	{
+		if (std::is_constant_evaluated())
 		{
-			ptr -= offset;
-			return *this;
+			for (; count != 0; --count, ++first, ++destination)
+			{
+				std::construct_at(std::to_address(destination), std::move(*first));
+			}
+			return destination;
 		}
+		return std::uninitialized_move_n(first, count, destination).second;
+	}
 
-		constexpr reference operator[](const size_t offset) const noexcept
+	template <typename Iterator, typename Output>
+	constexpr Output uninitialized_move(Iterator first, Iterator last, Output destination)
+	{
+		if (std::is_constant_evaluated())
 		{
-			return ptr[offset];
+			for (; first != last; ++first, ++destination)
+			{
+				std::construct_at(std::to_address(destination), std::move(*first));
+			}
+			return destination;
 		}
+		return std::uninitialized_move(first, last, destination);
+	}
 
-		constexpr friend bool operator==(const iterator it_a, const iterator it_b) noexcept
+	template <typename Output, typename T>
+	constexpr Output uninitialized_fill_n(Output destination, std::size_t count, const T& value)
+	{
+		if (std::is_constant_evaluated())
 		{
-			return it_a.ptr == it_b.ptr;
+			for (; count != 0; --count, ++destination)
+			{
+				std::construct_at(std::to_address(destination), value);
+			}
+			return destination;
 		}
+		return std::uninitialized_fill_n(destination, count, value);
+	}
 
-		constexpr friend bool operator!=(const iterator it_a, const iterator it_b) noexcept
+	template <typename Output>
+	constexpr Output uninitialized_value_construct_n(Output destination, std::size_t count)
+	{
+		if (std::is_constant_evaluated())
 		{
-			return it_a.ptr != it_b.ptr;
+			for (; count != 0; --count, ++destination)
+			{
+				std::construct_at(std::to_address(destination));
+			}
+			return destination;
 		}
+		return std::uninitialized_value_construct_n(destination, count);
+	}
 
-		constexpr friend iterator operator+(const iterator it, const size_t offset) noexcept
+	// Exchanges the contents of two non overlapping byte ranges through a small stack buffer, so the stack use doesn't grow with the ranges.
+	inline void swap_bytes(void* left, void* right, std::size_t bytes) noexcept
+	{
+		constexpr std::size_t chunk = 256;
+		unsigned char buffer[chunk];
+
+		auto* l = static_cast<unsigned char*>(left);
+		auto* r = static_cast<unsigned char*>(right);
+
+		while (bytes != 0)
 		{
-			T* result = it.ptr + offset;
-			return iterator(result);
+			const std::size_t step = std::min(bytes, chunk);
+			std::memcpy(buffer, l, step);
+			std::memcpy(l, r, step);
+			std::memcpy(r, buffer, step);
+			l += step;
+			r += step;
+			bytes -= step;
 		}
+	}
 
-		constexpr friend iterator operator+(const size_t offset, const iterator& it) noexcept
+	// The cache line size assumed for layout decisions. std::hardware_destructive_interference_size would be the portable spelling,
+	// but it isn't available everywhere and compilers warn about its value not being stable across targets.
+	constexpr std::size_t cache_line_bytes = 64;
+
+	constexpr std::size_t round_up(std::size_t value, std::size_t alignment) noexcept
+	{
+		return (value + alignment - 1) / alignment * alignment;
+	}
+
+	// Mirrors the layout of static_vector: the element buffer followed by the size field, rounded up to the strictest alignment of the two.
+	template <typename T>
+	constexpr std::size_t layout_bytes(std::size_t capacity, std::size_t buffer_alignment = alignof(T)) noexcept
+	{
+		const std::size_t size_bytes = size_type_bytes(capacity);
+		const std::size_t alignment = std::max(buffer_alignment, size_bytes);
+		return round_up(round_up(capacity * sizeof(T), size_bytes) + size_bytes, alignment);
+	}
+
+	// What the element buffer of a static_vector<T, Capacity, Policy> is aligned to, see static_vector_alignment.
+	template <typename T, typename Policy>
+	constexpr std::size_t buffer_alignment = []
+	{
+		std::size_t alignment = alignof(T);
+		if constexpr (requires { { Policy::element_alignment } -> std::convertible_to<std::size_t>; })
 		{
-			auto aux = offset + it.ptr;
-			return iterator(aux);
+			alignment = std::max<std::size_t>(alignment, Policy::element_alignment);
 		}
-
-		constexpr friend iterator operator-(const iterator it, const size_t offset) noexcept
+		if constexpr (requires { { Policy::pads_to_cache_line } -> std::convertible_to<bool>; })
 		{
-			T* aux = it.ptr - offset;
-			return iterator(aux);
+			alignment = Policy::pads_to_cache_line ? std::max(alignment, cache_line_bytes) : alignment;
 		}
+		return alignment;
+	}();
 
-		constexpr friend difference_type operator-(const iterator a, const iterator b) noexcept
+	template <typename T, std::size_t Capacity, typename Policy>
+	constexpr bool copies_live_prefix = []
+	{
+		if constexpr (requires { { Policy::copies_live_prefix } -> std::convertible_to<bool>; })
 		{
-			return a.ptr - b.ptr;
+			return static_cast<bool>(Policy::copies_live_prefix);
 		}
-
-		constexpr friend auto operator<=>(const iterator a, const iterator b) noexcept
+		else
 		{
-			return a.ptr <=> b.ptr;
+			return sizeof(T) * Capacity > STATIC_VECTOR_LIVE_PREFIX_COPY_BYTES;
 		}
+	}();
 
-	private:
-		pointer ptr;
-	};
-	struct const_iterator
+	// What a static_vector derives from when its policy doesn't instrument it, every hook does nothing. An instrumenting policy's
+	// instrumentation<T, Capacity> provides the same members, plus a size_t peak() const for the largest size the vector has had:
+	//  - void grown(std::size_t size), after the size may have gone up,
+	//  - static void overflowed(), when an operation would have exceeded the capacity,
+	//  - static void shifted(std::size_t count), when an insertion or an erasure moved count elements to open or close a gap,
+	//  - static void copied() and static void moved(), when a whole vector is copied or moved into another of the same type.
+	// Copies and moves of it are made by static_vector's own copy and move operations, which call the hooks.
+	struct no_instrumentation
 	{
-		using difference_type = ptrdiff_t;
-		using value_type = T;
-		using element_type = T;
-		using pointer = const T*;
-		using reference = const T&;
-		using iterator_category = std::contiguous_iterator_tag;
+		constexpr void grown(std::size_t) noexcept {}
+		static constexpr void overflowed() noexcept {}
+		static constexpr void shifted(std::size_t) noexcept {}
+		static constexpr void copied() noexcept {}
+		static constexpr void moved() noexcept {}
+	};
 
-		friend struct iterator;
+	template <typename T, std::size_t Capacity, typename Policy>
+	struct instrumentation_for
+	{
+		using type = no_instrumentation;
+	};
 
-		constexpr const_iterator() noexcept : ptr{} {};
-		constexpr const_iterator(const const_iterator&) noexcept = default;
-		constexpr const_iterator(const_iterator&&) noexcept = default;
-		constexpr const_iterator(pointer other) noexcept : ptr{ other } {}
+	template <typename T, std::size_t Capacity, typename Policy> requires requires { typename Policy::template instrumentation<T, Capacity>; }
+	struct instrumentation_for<T, Capacity, Policy>
+	{
+		using type = typename Policy::template instrumentation<T, Capacity>;
+	};
 
-		constexpr const_iterator(bool) = delete;
+	// The largest capacity for which a static_vector<T, Capacity> (elements and size) fits in Bytes.
+	template <typename T, std::size_t Bytes, std::size_t Buffer_Alignment = alignof(T)>
+	constexpr std::size_t capacity_for_bytes = []
+	{
+		std::size_t capacity = Bytes / sizeof(T);
+		while (capacity > 0 && layout_bytes<T>(capacity, Buffer_Alignment) > Bytes)
+		{
+			--capacity;
+		}
+		return capacity;
+	}();
+}
 
-		constexpr const_iterator(const iterator other) noexcept : ptr{ other.ptr } {}
+// Linear searches for arithmetic element types. The kernels compare a whole register of elements at a time and turn the result into a bit mask,
+// one bit per byte, so a match at byte b is element b / sizeof(T). They are handed the number of elements that may be read, which for
+// a static_vector is its capacity, so blocks straddling the size don't need a scalar tail: the bits of the dead elements are masked off.
+// Only the last block that would cross the end of the buffer is finished with a scalar loop.
+namespace static_vector_detail
+{
+	template <typename T>
+	constexpr bool is_simd_searchable_v = STATIC_VECTOR_HAS_SIMD && (std::is_arithmetic_v<T> || std::is_enum_v<T>) &&
+		(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
 
-		constexpr const_iterator& operator=(const const_iterator&) noexcept = default;
+	constexpr std::size_t not_found = std::numeric_limits<std::size_t>::max();
 
-		constexpr const_iterator& operator=(const_iterator&&) noexcept = default;
+	// The mask of the first valid_bytes bytes of a block.
+	constexpr std::uint32_t live_bytes_mask(std::size_t valid_bytes) noexcept
+	{
+		return valid_bytes >= 32 ? ~std::uint32_t{ 0 } : (std::uint32_t{ 1 } << valid_bytes) - 1;
+	}
 
-		constexpr const_iterator& operator= (const pointer other) noexcept
+#if STATIC_VECTOR_HAS_SIMD
+	inline bool cpu_has_avx2() noexcept
+	{
+		static const bool has_avx2 = []
 		{
-			ptr = other;
-			return (*this);
-		}
+#if defined(_MSC_VER) && !defined(__clang__)
+			int registers[4]{};
+			__cpuid(registers, 0);
+			if (registers[0] < 7)
+			{
+				return false;
+			}
+			__cpuid(registers, 1);
+			// The OS must save the ymm registers (OSXSAVE and the AVX state bits of XCR0) for AVX2 to be usable.
+			if ((registers[2] & (1 << 27)) == 0 || (_xgetbv(0) & 0x6) != 0x6)
+			{
+				return false;
+			}
+			__cpuidex(registers, 7, 0);
+			return (registers[1] & (1 << 5)) != 0;
+#else
+			return __builtin_cpu_supports("avx2") != 0;
+#endif
+		}();
 
-		constexpr reference operator* () const noexcept
-		{
-			return *ptr;
-		}
+		return has_avx2;
+	}
 
-		constexpr pointer operator-> () const noexcept
-		{
-			return ptr;
-		}
+	template <typename T>
+	inline std::uint32_t equal_mask_sse2(const T* block, __m128i needle) noexcept
+	{
+		const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
 
-		constexpr const_iterator& operator++ () noexcept
+		if constexpr (std::is_same_v<T, float>)
 		{
-			++ptr;
-			return *this;
+			return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(values), _mm_castsi128_ps(needle)))));
 		}
-
-		constexpr const_iterator operator++(int) noexcept
+		else if constexpr (std::is_same_v<T, double>)
 		{
-			return const_iterator(ptr++);
+			return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(values), _mm_castsi128_pd(needle)))));
 		}
-
-		constexpr const_iterator& operator-- () noexcept
+		else if constexpr (sizeof(T) == 1)
 		{
-			--ptr;
-			return *this;
+			return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(values, needle)));
 		}
-
-		constexpr const_iterator operator--(int) noexcept
+		else if constexpr (sizeof(T) == 2)
 		{
-			return const_iterator(ptr--);
+			return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi16(values, needle)));
 		}
-
-		constexpr const_iterator& operator+=(const size_t offset) noexcept
+		else if constexpr (sizeof(T) == 4)
 		{
-			ptr += offset;
-			return *this;
+			return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi32(values, needle)));
 		}
-
-		constexpr const_iterator& operator-=(const size_t offset) noexcept
+		else
 		{
-			ptr -= offset;
-			return *this;
+			// SSE2 has no 64 bit compare: both 32 bit halves have to match, so the result is and-ed with itself with the halves swapped.
+			const __m128i halves = _mm_cmpeq_epi32(values, needle);
+			return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)))));
 		}
+	}
 
-		constexpr reference operator[](const size_t offset) const noexcept
-		{
-			return ptr[offset];
-		}
+	template <typename T>
+	inline __m128i broadcast_sse2(T value) noexcept
+	{
+		alignas(16) T lanes[16 / sizeof(T)];
+		std::fill_n(lanes, 16 / sizeof(T), value);
+		return _mm_load_si128(reinterpret_cast<const __m128i*>(lanes));
+	}
 
-		constexpr friend bool operator==(const const_iterator it_a, const const_iterator it_b) noexcept
-		{
-			return it_a.ptr == it_b.ptr;
-		}
+	template <typename T>
+	STATIC_VECTOR_TARGET_AVX2 inline std::uint32_t equal_mask_avx2(const T* block, __m256i needle) noexcept
+	{
+		const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
 
-		constexpr friend bool operator==(const const_iterator it, const pointer adr) noexcept
+		if constexpr (std::is_same_v<T, float>)
 		{
-			return it.ptr == adr;
+			return static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(values), _mm256_castsi256_ps(needle), _CMP_EQ_OQ))));
 		}
-
-		constexpr friend bool operator!=(const const_iterator it_a, const const_iterator it_b) noexcept
+		else if constexpr (std::is_same_v<T, double>)
 		{
-			return it_a.ptr != it_b.ptr;
+			return static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(values), _mm256_castsi256_pd(needle), _CMP_EQ_OQ))));
 		}
-
-		constexpr friend bool operator!=(const const_iterator it, const pointer adr) noexcept
+		else if constexpr (sizeof(T) == 1)
 		{
-			return it.ptr != adr;
+			return static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(values, needle)));
 		}
-
-		constexpr friend const_iterator operator+(const const_iterator& it, const size_t offset) noexcept
+		else if constexpr (sizeof(T) == 2)
 		{
-			return const_iterator(it.ptr + offset);
+			return static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi16(values, needle)));
 		}
-
-		constexpr friend const_iterator operator+(const size_t offset, const const_iterator it) noexcept
+		else if constexpr (sizeof(T) == 4)
 		{
-			return const_iterator(offset + it.ptr);
+			return static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi32(values, needle)));
 		}
-
-		constexpr friend const_iterator operator-(const const_iterator it, const size_t offset) noexcept
+		else
 		{
-			return const_iterator(it.ptr - offset);
+			return static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi64(values, needle)));
 		}
+	}
 
-		constexpr friend difference_type operator-(const const_iterator a, const const_iterator b) noexcept
+	template <typename T>
+	STATIC_VECTOR_TARGET_AVX2 inline __m256i broadcast_avx2(T value) noexcept
+	{
+		alignas(32) T lanes[32 / sizeof(T)];
+		std::fill_n(lanes, 32 / sizeof(T), value);
+		return _mm256_load_si256(reinterpret_cast<const __m256i*>(lanes));
+	}
+
+	// Both kernels scan [0, size) of a buffer of which the first readable elements can be loaded, and return where they stopped,
+	// leaving the rest to the scalar loop. find_* return the index of the first match, or not_found.
+	template <typename T>
+	inline std::size_t find_sse2(const T* data, std::size_t size, std::size_t readable, T value, std::size_t& scanned) noexcept
+	{
+		constexpr std::size_t lanes = 16 / sizeof(T);
+		const __m128i needle = broadcast_sse2(value);
+
+		std::size_t i = 0;
+		for (; i < size && i + lanes <= readable; i += lanes)
 		{
-			return a.ptr - b.ptr;
+			const std::uint32_t mask = equal_mask_sse2(data + i, needle) & live_bytes_mask((size - i) * sizeof(T));
+			if (mask != 0)
+			{
+				return i + static_cast<std::size_t>(std::countr_zero(mask)) / sizeof(T);
+			}
 		}
 
-		constexpr friend auto operator<=>(const const_iterator a, const const_iterator b) noexcept
+		scanned = i;
+		return not_found;
+	}
+
+	template <typename T>
+	STATIC_VECTOR_TARGET_AVX2 inline std::size_t find_avx2(const T* data, std::size_t size, std::size_t readable, T value, std::size_t& scanned) noexcept
+	{
+		constexpr std::size_t lanes = 32 / sizeof(T);
+		const __m256i needle = broadcast_avx2(value);
+
+		std::size_t i = 0;
+		for (; i < size && i + lanes <= readable; i += lanes)
 		{
-			return a.ptr <=> b.ptr;
+			const std::uint32_t mask = equal_mask_avx2(data + i, needle) & live_bytes_mask((size - i) * sizeof(T));
+			if (mask != 0)
+			{
+				return i + static_cast<std::size_t>(std::countr_zero(mask)) / sizeof(T);
+			}
 		}
 
-	private:
+		scanned = i;
+		return not_found;
+	}
 
-		pointer ptr;
+	template <typename T>
+	inline std::size_t count_sse2(const T* data, std::size_t size, std::size_t readable, T value, std::size_t& scanned) noexcept
+	{
+		constexpr std::size_t lanes = 16 / sizeof(T);
+		const __m128i needle = broadcast_sse2(value);
+
+		std::size_t matching_bytes = 0;
+		std::size_t i = 0;
+		for (; i < size && i + lanes <= readable; i += lanes)
+		{
+			matching_bytes += static_cast<std::size_t>(std::popcount(equal_mask_sse2(data + i, needle) & live_bytes_mask((size - i) * sizeof(T))));
+		}
+
+		scanned = i;
+		return matching_bytes / sizeof(T);
+	}
+
+	template <typename T>
+	STATIC_VECTOR_TARGET_AVX2 inline std::size_t count_avx2(const T* data, std::size_t size, std::size_t readable, T value, std::size_t& scanned) noexcept
+	{
+		constexpr std::size_t lanes = 32 / sizeof(T);
+		const __m256i needle = broadcast_avx2(value);
+
+		std::size_t matching_bytes = 0;
+		std::size_t i = 0;
+		for (; i < size && i + lanes <= readable; i += lanes)
+		{
+			matching_bytes += static_cast<std::size_t>(std::popcount(equal_mask_avx2(data + i, needle) & live_bytes_mask((size - i) * sizeof(T))));
+		}
+
+		scanned = i;
+		return matching_bytes / sizeof(T);
+	}
+#endif
+
+	template <typename T>
+	constexpr bool is_nothrow_equality_comparable_v = noexcept(std::declval<const T&>() == std::declval<const T&>());
+
+	// The index of the first element of [0, size) equal to value, or not_found. readable >= size is how many elements may be loaded.
+	template <typename T>
+	constexpr std::size_t find_index(const T* data, std::size_t size, [[maybe_unused]] std::size_t readable, const T& value) noexcept (is_nothrow_equality_comparable_v<T>)
+	{
+		std::size_t i = 0;
+
+#if STATIC_VECTOR_HAS_SIMD
+		if constexpr (is_simd_searchable_v<T>)
+		{
+			if (!std::is_constant_evaluated())
+			{
+				const std::size_t found = readable * sizeof(T) >= 32 && cpu_has_avx2()
+					? find_avx2(data, size, readable, value, i)
+					: find_sse2(data, size, readable, value, i);
+
+				if (found != not_found)
+				{
+					return found;
+				}
+			}
+		}
+#endif
+
+		for (; i < size; ++i)
+		{
+			if (data[i] == value)
+			{
+				return i;
+			}
+		}
+
+		return not_found;
+	}
+
+	template <typename T>
+	constexpr std::size_t count_equal(const T* data, std::size_t size, [[maybe_unused]] std::size_t readable, const T& value) noexcept (is_nothrow_equality_comparable_v<T>)
+	{
+		std::size_t i = 0;
+		std::size_t count = 0;
+
+#if STATIC_VECTOR_HAS_SIMD
+		if constexpr (is_simd_searchable_v<T>)
+		{
+			if (!std::is_constant_evaluated())
+			{
+				count = readable * sizeof(T) >= 32 && cpu_has_avx2()
+					? count_avx2(data, size, readable, value, i)
+					: count_sse2(data, size, readable, value, i);
+			}
+		}
+#endif
+
+		for (; i < size; ++i)
+		{
+			count += data[i] == value;
+		}
+
+		return count;
+	}
+}
+
+// A static_vector holding as many elements as fit in Bytes, size field included, e.g. byte_budget_static_vector<std::uint8_t, 64> is exactly 64 bytes.
+template <typename T, std::size_t Bytes, typename Policy = static_vector_default_policy>
+using byte_budget_static_vector = static_vector<T, static_vector_detail::capacity_for_bytes<T, Bytes, static_vector_detail::buffer_alignment<T, Policy>>, Policy>;
+
+// A static_vector that fills exactly one (64 byte) cache line.
+template <typename T, typename Policy = static_vector_default_policy>
+using cache_line_static_vector = byte_budget_static_vector<T, static_vector_detail::cache_line_bytes, Policy>;
+
+// A static_vector whose element buffer is aligned to Alignment bytes, a cache line by default, see static_vector_alignment.
+template <typename T, std::size_t Capacity, std::size_t Alignment = static_vector_detail::cache_line_bytes, bool Pad_To_Cache_Line = false,
+	typename Policy = static_vector_default_policy>
+using aligned_static_vector = static_vector<T, Capacity, static_vector_alignment<Alignment, Pad_To_Cache_Line, Policy>>;
+
+// The wire format static_vector::serialize_into writes for trivially copyable elements, read back by deserialize_from and viewed in place
+// by static_vector_view:
+//
+//   offset  bytes  field
+//   0       4      magic, the characters 'S' 'V' 'E' 'C'
+//   4       1      format version, static_vector_wire_version
+//   5       1      byte order of the writer, static_vector_wire_little_endian or static_vector_wire_big_endian
+//   6       2      alignof(T)
+//   8       4      sizeof(T)
+//   12      4      reserved, zero
+//   16      8      element count
+//   24             padding up to a multiple of alignof(T), then the elements, count * sizeof(T) bytes
+//
+// Fields are in the writer's byte order and the elements are their object representations, padding bytes included, so a buffer can only
+// be read where T has the same layout. Readers check that as far as the byte order, size and alignment go.
+struct static_vector_wire_header
+{
+	char magic[4];
+	std::uint8_t version;
+	std::uint8_t byte_order;
+	std::uint16_t element_alignment;
+	std::uint32_t element_size;
+	std::uint32_t reserved;
+	std::uint64_t count;
+};
+
+inline constexpr std::uint8_t static_vector_wire_version = 1;
+inline constexpr std::uint8_t static_vector_wire_little_endian = 1;
+inline constexpr std::uint8_t static_vector_wire_big_endian = 2;
+
+// Why a buffer couldn't be read.
+enum class static_vector_wire_status : std::uint8_t
+{
+	ok,
+	buffer_too_small,       // shorter than the header, or than the elements it announces
+	bad_magic,
+	unsupported_version,
+	byte_order_mismatch,
+	layout_mismatch,        // the element size or alignment differ from T's
+	too_many_elements,      // more elements than the destination's capacity
+	misaligned              // the elements aren't aligned for T in memory, so they can't be viewed in place
+};
+
+// The header static_vector::create_at places at the front of a shared memory region, followed by the vector itself at the next multiple
+// of its alignment. attach checks it against the static_vector it expects, reporting mismatches with static_vector_wire_status.
+// The fields are those of static_vector_wire_header, plus the capacity and the object size that make up the layout of the vector.
+// magic is stored last, with release ordering, so a process attaching while the region is being created sees it as not created yet.
+struct static_vector_region_header
+{
+	std::uint32_t magic;
+	std::uint8_t version;
+	std::uint8_t byte_order;
+	std::uint16_t element_alignment;
+	std::uint32_t element_size;
+	std::uint32_t reserved;
+	std::uint64_t capacity;
+	std::uint64_t object_size;
+};
+
+inline constexpr std::uint32_t static_vector_region_magic = 0x48535653; // "SVSH" in little endian byte order
+
+namespace static_vector_detail
+{
+	static_assert(sizeof(static_vector_wire_header) == 24);
+	static_assert(sizeof(static_vector_region_header) == 32);
+	static_assert(std::endian::native == std::endian::little || std::endian::native == std::endian::big, "mixed endian targets have no wire byte order");
+
+	inline constexpr std::uint8_t wire_native_byte_order = std::endian::native == std::endian::little ? static_vector_wire_little_endian : static_vector_wire_big_endian;
+
+	// Where the elements start, relative to the header.
+	template <typename T>
+	inline constexpr std::size_t wire_data_offset = round_up(sizeof(static_vector_wire_header), alignof(T));
+
+	template <typename T>
+	inline void write_wire_header(std::byte* destination, std::size_t count) noexcept
+	{
+		const static_vector_wire_header header{
+			{ 'S', 'V', 'E', 'C' },
+			static_vector_wire_version,
+			wire_native_byte_order,
+			static_cast<std::uint16_t>(alignof(T)),
+			static_cast<std::uint32_t>(sizeof(T)),
+			0,
+			static_cast<std::uint64_t>(count) };
+
+		std::memcpy(destination, &header, sizeof(header));
+		// Keeps the padding before the elements from leaking whatever the buffer held.
+		std::memset(destination + sizeof(header), 0, wire_data_offset<T> - sizeof(header));
+	}
+
+	// Validates the header at the front of bytes for elements of type T and that the elements it announces are all there.
+	// The buffer needs no particular alignment, the header is copied out of it.
+	template <typename T>
+	inline static_vector_wire_status read_wire_header(std::span<const std::byte> bytes, std::size_t& count) noexcept
+	{
+		if (bytes.size() < sizeof(static_vector_wire_header))
+		{
+			return static_vector_wire_status::buffer_too_small;
+		}
+
+		static_vector_wire_header header;
+		std::memcpy(&header, bytes.data(), sizeof(header));
+
+		if (std::memcmp(header.magic, "SVEC", sizeof(header.magic)) != 0)
+		{
+			return static_vector_wire_status::bad_magic;
+		}
+		if (header.version != static_vector_wire_version)
+		{
+			return static_vector_wire_status::unsupported_version;
+		}
+		if (header.byte_order != wire_native_byte_order)
+		{
+			return static_vector_wire_status::byte_order_mismatch;
+		}
+		if (header.element_size != sizeof(T) || header.element_alignment != alignof(T))
+		{
+			return static_vector_wire_status::layout_mismatch;
+		}
+		// Divides rather than multiplies, a corrupt count could overflow.
+		if (bytes.size() < wire_data_offset<T> || header.count > (bytes.size() - wire_data_offset<T>) / sizeof(T))
+		{
+			return static_vector_wire_status::buffer_too_small;
+		}
+
+		count = static_cast<std::size_t>(header.count);
+		return static_vector_wire_status::ok;
+	}
+
+	// The element buffer of static_vector. An array in a union rather than raw bytes, so that its elements are real T objects that
+	// constant evaluation can construct, destroy and access one by one: a static_vector can be filled in a constexpr function and
+	// the result kept in a constexpr variable, in read-only data.
+	// Trivial elements are zeroed up front instead, like raw bytes would be, because a constant can't hold uninitialized elements.
+	// Constructors that initialize the whole buffer themselves skip that by passing uninitialized_storage.
+	// Either way the buffer has the size and alignment of T[Capacity] and is trivially copyable whenever T is.
+	template <typename T>
+	constexpr bool zeroes_elements = std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>;
+
+	struct uninitialized_storage_t
+	{
+		explicit uninitialized_storage_t() = default;
 	};
 
-	struct const_reverse_iterator;
-	struct reverse_iterator
+	inline constexpr uninitialized_storage_t uninitialized_storage{};
+
+	template <typename T, std::size_t Capacity, bool = zeroes_elements<T>>
+	struct element_storage
+	{
+		constexpr element_storage() noexcept : elements{} {}
+		constexpr explicit element_storage(uninitialized_storage_t) noexcept {}
+
+		union
+		{
+			T elements[Capacity];
+		};
+	};
+
+	template <typename T, std::size_t Capacity>
+	struct element_storage<T, Capacity, false>
+	{
+		constexpr element_storage() noexcept {}
+		constexpr explicit element_storage(uninitialized_storage_t) noexcept {}
+
+		// The elements are destroyed by static_vector, a union only gets a destructor of its own when T's would be deleted from it.
+		constexpr ~element_storage() requires (std::is_trivially_destructible_v<T>) = default;
+		constexpr ~element_storage() {}
+
+		union
+		{
+			T elements[Capacity];
+		};
+	};
+}
+
+
+template <typename T, size_t Capacity, typename Policy>
+class static_vector : private static_vector_detail::instrumentation_for<T, Capacity, Policy>::type
+{
+	using instrumentation_type = typename static_vector_detail::instrumentation_for<T, Capacity, Policy>::type;
+	static constexpr bool instrumented = !std::is_same_v<instrumentation_type, static_vector_detail::no_instrumentation>;
+
+	using size_field_type = static_vector_detail::size_type_for<Capacity>;
+
+	static constexpr std::size_t buffer_alignment = static_vector_detail::buffer_alignment<T, Policy>;
+
+	// Holds the elements without constructing them, see static_vector_detail::element_storage. It comes first, so aligning it aligns the vector.
+	alignas(buffer_alignment) static_vector_detail::element_storage<T, Capacity> _storage;
+	// The size is stored in the smallest type that can hold Capacity and placed after the elements, so it only occupies what would otherwise be tail padding.
+	size_field_type _size = 0;
+
+public:
+
+	template<typename U, std::size_t Other_Size, typename Other_Policy>
+	friend class static_vector;
+
+	template<typename U, std::size_t N, typename Allocator>
+	friend class small_vector;
+
+	template <typename U, std::size_t Other_Capacity, typename Other_Policy, typename Predicate> requires (std::predicate<Predicate&, U&>)
+	friend constexpr std::size_t erase_if(static_vector<U, Other_Capacity, Other_Policy>& vector, Predicate predicate);
+
+	struct const_iterator;
+	struct iterator
 	{
 		using difference_type = ptrdiff_t;
 		using value_type = T;
@@ -283,17 +947,17 @@ public:
 		using reference = T&;
 		using iterator_category = std::contiguous_iterator_tag;
 
-		friend struct const_reverse_iterator;
+		friend struct const_iterator;
 
-		constexpr reverse_iterator() noexcept : ptr{} {};
-		constexpr reverse_iterator(const reverse_iterator&) noexcept = default;
-		constexpr reverse_iterator(reverse_iterator&&) noexcept = default;
-		constexpr reverse_iterator(pointer other) noexcept : ptr{ other } {}
-		constexpr reverse_iterator(bool) = delete;
+		constexpr iterator() noexcept : ptr{} {};
+		constexpr iterator(const iterator&) noexcept = default;
+		constexpr iterator(iterator&&) noexcept = default;
+		constexpr iterator(pointer other) noexcept : ptr{ other } {}
+		constexpr iterator(bool) = delete;
 
-		constexpr reverse_iterator& operator=(const reverse_iterator&) = default;
+		constexpr iterator& operator=(const iterator&) = default;
 
-		constexpr reverse_iterator& operator=(reverse_iterator&&) = default;
+		constexpr iterator& operator=(iterator&&) = default;
 
 		constexpr reference operator* () const noexcept
 		{
@@ -305,87 +969,87 @@ public:
 			return ptr;
 		}
 
-		constexpr reverse_iterator& operator++ () noexcept
+		constexpr iterator& operator++ () noexcept
 		{
-			--ptr;
+			++ptr;
 			return *this;
 		}
 
-		constexpr reverse_iterator operator++(int) noexcept
+		constexpr iterator operator++(int) noexcept
 		{
-			return iterator(ptr--);
+			return iterator(ptr++);
 		}
 
-		constexpr reverse_iterator& operator-- () noexcept
+		constexpr iterator& operator-- () noexcept
 		{
-			++ptr;
+			--ptr;
 			return *this;
 		}
 
-		constexpr reverse_iterator operator--(int) noexcept
+		constexpr iterator operator--(int) noexcept
 		{
-			return iterator(ptr++);
+			return iterator(ptr--);
 		}
 
-		constexpr reverse_iterator& operator+=(const ptrdiff_t offset) noexcept
+		constexpr iterator& operator+=(const ptrdiff_t offset) noexcept
 		{
-			ptr -= offset;
+			ptr += offset;
 			return *this;
 		}
 
-		constexpr reverse_iterator& operator-=(const ptrdiff_t offset) noexcept
+		constexpr iterator& operator-=(const ptrdiff_t offset) noexcept
 		{
-			ptr += offset;
+			ptr -= offset;
 			return *this;
 		}
 
-		constexpr reverse_iterator operator[](const size_t offset) const noexcept
+		constexpr reference operator[](const size_t offset) const noexcept
 		{
 			return ptr[offset];
 		}
 
-		constexpr friend bool operator==(const reverse_iterator it_a, const reverse_iterator it_b) noexcept
+		constexpr friend bool operator==(const iterator it_a, const iterator it_b) noexcept
 		{
 			return it_a.ptr == it_b.ptr;
 		}
 
-		constexpr friend bool operator!=(const reverse_iterator it_a, const reverse_iterator it_b) noexcept
+		constexpr friend bool operator!=(const iterator it_a, const iterator it_b) noexcept
 		{
 			return it_a.ptr != it_b.ptr;
 		}
 
-		constexpr friend reverse_iterator operator+(const reverse_iterator it, const size_t offset) noexcept
+		constexpr friend iterator operator+(const iterator it, const size_t offset) noexcept
 		{
-			T* result = it.ptr - offset;
-			return reverse_iterator(result);
+			T* result = it.ptr + offset;
+			return iterator(result);
 		}
 
-		constexpr friend reverse_iterator operator+(const size_t offset, const reverse_iterator& it) noexcept
+		constexpr friend iterator operator+(const size_t offset, const iterator& it) noexcept
 		{
-			auto aux = offset - it.ptr;
-			return reverse_iterator(aux);
+			auto aux = offset + it.ptr;
+			return iterator(aux);
 		}
 
-		constexpr friend reverse_iterator operator-(const reverse_iterator it, const size_t offset) noexcept
+		constexpr friend iterator operator-(const iterator it, const size_t offset) noexcept
 		{
-			T* aux = it.ptr + offset;
+			T* aux = it.ptr - offset;
 			return iterator(aux);
 		}
 
-		constexpr friend difference_type operator-(const reverse_iterator a, const reverse_iterator b) noexcept
+		constexpr friend difference_type operator-(const iterator a, const iterator b) noexcept
 		{
-			return a.ptr + b.ptr;
+			return a.ptr - b.ptr;
 		}
 
-		constexpr friend auto operator<=>(const reverse_iterator a, const reverse_iterator b) noexcept
+		constexpr friend auto operator<=>(const iterator a, const iterator b) noexcept
 		{
-			return b.ptr <=> a.ptr;
+			return a.ptr <=> b.ptr;
 		}
 
 	private:
 		pointer ptr;
 	};
-	struct const_reverse_iterator
+	struct const_iterator
 	{
 		using difference_type = ptrdiff_t;
 		using value_type = T;
@@ -394,22 +1058,22 @@ public:
 		using reference = const T&;
 		using iterator_category = std::contiguous_iterator_tag;
 
-		friend struct reverse_iterator;
+		friend struct iterator;
 
-		constexpr const_reverse_iterator() noexcept : ptr{} {};
-		constexpr const_reverse_iterator(const const_reverse_iterator&) noexcept = default;
-		constexpr const_reverse_iterator(const_reverse_iterator&&) noexcept = default;
-		constexpr const_reverse_iterator(pointer other) noexcept : ptr{ other } {}
+		constexpr const_iterator() noexcept : ptr{} {};
+		constexpr const_iterator(const const_iterator&) noexcept = default;
+		constexpr const_iterator(const_iterator&&) noexcept = default;
+		constexpr const_iterator(pointer other) noexcept : ptr{ other } {}
 
-		constexpr const_reverse_iterator(bool) = delete;
+		constexpr const_iterator(bool) = delete;
 
-		constexpr const_reverse_iterator(const iterator other) noexcept : ptr{ other.ptr } {}
+		constexpr const_iterator(const iterator other) noexcept : ptr{ other.ptr } {}
 
-		constexpr const_reverse_iterator& operator=(const const_reverse_iterator&) noexcept = default;
+		constexpr const_iterator& operator=(const const_iterator&) noexcept = default;
 
-		constexpr const_reverse_iterator& operator=(const_reverse_iterator&&) noexcept = default;
+		constexpr const_iterator& operator=(const_iterator&&) noexcept = default;
 
-		constexpr const_reverse_iterator& operator= (const pointer other) noexcept
+		constexpr const_iterator& operator= (const pointer other) noexcept
 		{
 			ptr = other;
 			return (*this);
@@ -425,37 +1089,37 @@ public:
 			return ptr;
 		}
 
-		constexpr const_reverse_iterator& operator++ () noexcept
+		constexpr const_iterator& operator++ () noexcept
 		{
-			--ptr;
+			++ptr;
 			return *this;
 		}
 
-		constexpr const_reverse_iterator operator++(int) noexcept
+		constexpr const_iterator operator++(int) noexcept
 		{
-			return const_reverse_iterator(ptr--);
+			return const_iterator(ptr++);
 		}
 
-		constexpr const_reverse_iterator& operator-- () noexcept
+		constexpr const_iterator& operator-- () noexcept
 		{
-			++ptr;
+			--ptr;
 			return *this;
 		}
 
-		constexpr const_reverse_iterator operator--(int) noexcept
+		constexpr const_iterator operator--(int) noexcept
 		{
-			return const_reverse_iterator(ptr++);
+			return const_iterator(ptr--);
 		}
 
-		constexpr const_reverse_iterator& operator+=(const size_t offset) noexcept
+		constexpr const_iterator& operator+=(const size_t offset) noexcept
 		{
-			ptr -= offset;
+			ptr += offset;
 			return *this;
 		}
 
-		constexpr const_reverse_iterator& operator-=(const size_t offset) noexcept
+		constexpr const_iterator& operator-=(const size_t offset) noexcept
 		{
-			ptr += offset;
+			ptr -= offset;
 			return *this;
 		}
 
@@ -464,44 +1128,286 @@ public:
 			return ptr[offset];
 		}
 
-		constexpr friend bool operator==(const const_reverse_iterator it_a, const const_reverse_iterator it_b) noexcept
+		constexpr friend bool operator==(const const_iterator it_a, const const_iterator it_b) noexcept
 		{
 			return it_a.ptr == it_b.ptr;
 		}
 
-		constexpr friend bool operator==(const const_reverse_iterator it, const pointer adr) noexcept
+		constexpr friend bool operator==(const const_iterator it, const pointer adr) noexcept
 		{
 			return it.ptr == adr;
 		}
 
-		constexpr friend bool operator!=(const const_reverse_iterator it_a, const const_reverse_iterator it_b) noexcept
+		constexpr friend bool operator!=(const const_iterator it_a, const const_iterator it_b) noexcept
 		{
 			return it_a.ptr != it_b.ptr;
 		}
 
-		constexpr friend bool operator!=(const const_reverse_iterator it, const pointer adr) noexcept
+		constexpr friend bool operator!=(const const_iterator it, const pointer adr) noexcept
 		{
 			return it.ptr != adr;
 		}
 
-		constexpr friend const_reverse_iterator operator+(const const_reverse_iterator& it, const size_t offset) noexcept
+		constexpr friend const_iterator operator+(const const_iterator& it, const size_t offset) noexcept
 		{
-			return const_reverse_iterator(it.ptr - offset);
+			return const_iterator(it.ptr + offset);
 		}
 
-		constexpr friend const_reverse_iterator operator+(const size_t offset, const const_reverse_iterator it) noexcept
+		constexpr friend const_iterator operator+(const size_t offset, const const_iterator it) noexcept
 		{
-			return const_reverse_iterator(offset - it.ptr);
+			return const_iterator(offset + it.ptr);
 		}
 
-		constexpr friend const_reverse_iterator operator-(const const_reverse_iterator it, const size_t offset) noexcept
+		constexpr friend const_iterator operator-(const const_iterator it, const size_t offset) noexcept
+		{
+			return const_iterator(it.ptr - offset);
+		}
+
+		constexpr friend difference_type operator-(const const_iterator a, const const_iterator b) noexcept
+		{
+			return a.ptr - b.ptr;
+		}
+
+		constexpr friend auto operator<=>(const const_iterator a, const const_iterator b) noexcept
+		{
+			return a.ptr <=> b.ptr;
+		}
+
+	private:
+
+		pointer ptr;
+	};
+
+	struct const_reverse_iterator;
+	// Like std::reverse_iterator, the reverse iterators hold a pointer one past the element they refer to, so that rend() points
+	// at the first element rather than before the array, which constant evaluation doesn't allow.
+	struct reverse_iterator
+	{
+		using difference_type = ptrdiff_t;
+		using value_type = T;
+		using element_type = T;
+		using pointer = T*;
+		using reference = T&;
+		using iterator_category = std::contiguous_iterator_tag;
+
+		friend struct const_reverse_iterator;
+
+		constexpr reverse_iterator() noexcept : ptr{} {};
+		constexpr reverse_iterator(const reverse_iterator&) noexcept = default;
+		constexpr reverse_iterator(reverse_iterator&&) noexcept = default;
+		constexpr reverse_iterator(pointer other) noexcept : ptr{ other } {}
+		constexpr reverse_iterator(bool) = delete;
+
+		constexpr reverse_iterator& operator=(const reverse_iterator&) = default;
+
+		constexpr reverse_iterator& operator=(reverse_iterator&&) = default;
+
+		constexpr reference operator* () const noexcept
+		{
+			return *(ptr - 1);
+		}
+
+		constexpr pointer operator-> () const noexcept
+		{
+			return ptr - 1;
+		}
+
+		constexpr reverse_iterator& operator++ () noexcept
+		{
+			--ptr;
+			return *this;
+		}
+
+		constexpr reverse_iterator operator++(int) noexcept
+		{
+			return reverse_iterator(ptr--);
+		}
+
+		constexpr reverse_iterator& operator-- () noexcept
+		{
+			++ptr;
+			return *this;
+		}
+
+		constexpr reverse_iterator operator--(int) noexcept
+		{
+			return reverse_iterator(ptr++);
+		}
+
+		constexpr reverse_iterator& operator+=(const ptrdiff_t offset) noexcept
+		{
+			ptr -= offset;
+			return *this;
+		}
+
+		constexpr reverse_iterator& operator-=(const ptrdiff_t offset) noexcept
+		{
+			ptr += offset;
+			return *this;
+		}
+
+		constexpr reference operator[](const size_t offset) const noexcept
+		{
+			return *(ptr - offset - 1);
+		}
+
+		constexpr friend bool operator==(const reverse_iterator it_a, const reverse_iterator it_b) noexcept
+		{
+			return it_a.ptr == it_b.ptr;
+		}
+
+		constexpr friend bool operator!=(const reverse_iterator it_a, const reverse_iterator it_b) noexcept
+		{
+			return it_a.ptr != it_b.ptr;
+		}
+
+		constexpr friend reverse_iterator operator+(const reverse_iterator it, const size_t offset) noexcept
+		{
+			T* result = it.ptr - offset;
+			return reverse_iterator(result);
+		}
+
+		constexpr friend reverse_iterator operator+(const size_t offset, const reverse_iterator& it) noexcept
+		{
+			return it + offset;
+		}
+
+		constexpr friend reverse_iterator operator-(const reverse_iterator it, const size_t offset) noexcept
+		{
+			T* aux = it.ptr + offset;
+			return reverse_iterator(aux);
+		}
+
+		constexpr friend difference_type operator-(const reverse_iterator a, const reverse_iterator b) noexcept
+		{
+			return b.ptr - a.ptr;
+		}
+
+		constexpr friend auto operator<=>(const reverse_iterator a, const reverse_iterator b) noexcept
+		{
+			return b.ptr <=> a.ptr;
+		}
+
+	private:
+		pointer ptr;
+	};
+	struct const_reverse_iterator
+	{
+		using difference_type = ptrdiff_t;
+		using value_type = T;
+		using element_type = T;
+		using pointer = const T*;
+		using reference = const T&;
+		using iterator_category = std::contiguous_iterator_tag;
+
+		friend struct reverse_iterator;
+
+		constexpr const_reverse_iterator() noexcept : ptr{} {};
+		constexpr const_reverse_iterator(const const_reverse_iterator&) noexcept = default;
+		constexpr const_reverse_iterator(const_reverse_iterator&&) noexcept = default;
+		constexpr const_reverse_iterator(pointer other) noexcept : ptr{ other } {}
+
+		constexpr const_reverse_iterator(bool) = delete;
+
+		constexpr const_reverse_iterator(const iterator other) noexcept : ptr{ other.ptr } {}
+
+		constexpr const_reverse_iterator& operator=(const const_reverse_iterator&) noexcept = default;
+
+		constexpr const_reverse_iterator& operator=(const_reverse_iterator&&) noexcept = default;
+
+		constexpr const_reverse_iterator& operator= (const pointer other) noexcept
+		{
+			ptr = other;
+			return (*this);
+		}
+
+		constexpr reference operator* () const noexcept
+		{
+			return *(ptr - 1);
+		}
+
+		constexpr pointer operator-> () const noexcept
+		{
+			return ptr - 1;
+		}
+
+		constexpr const_reverse_iterator& operator++ () noexcept
+		{
+			--ptr;
+			return *this;
+		}
+
+		constexpr const_reverse_iterator operator++(int) noexcept
+		{
+			return const_reverse_iterator(ptr--);
+		}
+
+		constexpr const_reverse_iterator& operator-- () noexcept
+		{
+			++ptr;
+			return *this;
+		}
+
+		constexpr const_reverse_iterator operator--(int) noexcept
+		{
+			return const_reverse_iterator(ptr++);
+		}
+
+		constexpr const_reverse_iterator& operator+=(const size_t offset) noexcept
+		{
+			ptr -= offset;
+			return *this;
+		}
+
+		constexpr const_reverse_iterator& operator-=(const size_t offset) noexcept
+		{
+			ptr += offset;
+			return *this;
+		}
+
+		constexpr reference operator[](const size_t offset) const noexcept
+		{
+			return *(ptr - offset - 1);
+		}
+
+		constexpr friend bool operator==(const const_reverse_iterator it_a, const const_reverse_iterator it_b) noexcept
+		{
+			return it_a.ptr == it_b.ptr;
+		}
+
+		constexpr friend bool operator==(const const_reverse_iterator it, const pointer adr) noexcept
+		{
+			return it.ptr == adr;
+		}
+
+		constexpr friend bool operator!=(const const_reverse_iterator it_a, const const_reverse_iterator it_b) noexcept
+		{
+			return it_a.ptr != it_b.ptr;
+		}
+
+		constexpr friend bool operator!=(const const_reverse_iterator it, const pointer adr) noexcept
+		{
+			return it.ptr != adr;
+		}
+
+		constexpr friend const_reverse_iterator operator+(const const_reverse_iterator& it, const size_t offset) noexcept
+		{
+			return const_reverse_iterator(it.ptr - offset);
+		}
+
+		constexpr friend const_reverse_iterator operator+(const size_t offset, const const_reverse_iterator it) noexcept
+		{
+			return it + offset;
+		}
+
+		constexpr friend const_reverse_iterator operator-(const const_reverse_iterator it, const size_t offset) noexcept
 		{
 			return const_reverse_iterator(it.ptr + offset);
 		}
 
 		constexpr friend difference_type operator-(const const_reverse_iterator a, const const_reverse_iterator b) noexcept
 		{
-			return a.ptr + b.ptr;
+			return b.ptr - a.ptr;
 		}
 
 		constexpr friend auto operator<=>(const const_reverse_iterator a, const const_reverse_iterator b) noexcept
@@ -524,53 +1430,57 @@ public:
 
 	constexpr iterator begin() noexcept
 	{
-		return iterator(std::launder(reinterpret_cast<T*>(_data)));
+		return iterator(data());
 	}
 	constexpr iterator end() noexcept
 	{
-		return iterator(std::launder(reinterpret_cast<T*>(_data + _size)));
+		return iterator(_storage.elements + _size);
 	}
 	constexpr const_iterator begin() const noexcept
 	{
-		return const_iterator(std::launder(reinterpret_cast<const T*>(_data)));
+		return const_iterator(data());
 	}
 	constexpr const_iterator end() const noexcept
 	{
-		return const_iterator(std::launder(reinterpret_cast<const T*>(_data + _size)));
+		return const_iterator(_storage.elements + _size);
 	}
 	constexpr const_iterator cbegin() const noexcept
 	{
-		return const_iterator(std::launder(reinterpret_cast<const T*>(_data)));
+		return const_iterator(data());
 	}
 	constexpr const_iterator cend() const noexcept
 	{
-		return const_iterator(std::launder(reinterpret_cast<const T*>(_data + _size)));
+		return const_iterator(_storage.elements + _size);
 	}
 	constexpr reverse_iterator rbegin() noexcept
 	{
-		return reverse_iterator(std::launder(reinterpret_cast<T*>(_data + _size - 1)));
+		return reverse_iterator(_storage.elements + _size);
 	}
 	constexpr reverse_iterator rend() noexcept
 	{
-		return reverse_iterator(std::launder(reinterpret_cast<T*>(_data - 1)));
+		return reverse_iterator(_storage.elements);
 	}
 	constexpr const_reverse_iterator rbegin() const noexcept
 	{
-		return const_reverse_iterator(std::launder(reinterpret_cast<const T*>(_data + _size -1)));
+		return const_reverse_iterator(_storage.elements + _size);
 	}
 	constexpr const_reverse_iterator rend() const noexcept
 	{
-		return const_reverse_iterator(std::launder(reinterpret_cast<const T*>(_data - 1)));
+		return const_reverse_iterator(_storage.elements);
 	}
 	constexpr const_reverse_iterator crbegin() const noexcept
 	{
-		return const_reverse_iterator(std::launder(reinterpret_cast<const T*>(_data + _size - 1)));
+		return const_reverse_iterator(_storage.elements + _size);
 	}
 	constexpr const_reverse_iterator crend() const noexcept
 	{
-		return const_reverse_iterator(std::launder(reinterpret_cast<const T*>(_data - 1)));
+		return const_reverse_iterator(_storage.elements);
 	}
 
+	// Whether copies and moves of trivially copyable elements only copy the live elements, rather than the defaulted copy of the whole buffer.
+	// Instrumented vectors always do, the defaulted ones couldn't count the copies.
+	static constexpr bool live_prefix_copy = static_vector_detail::copies_live_prefix<T, Capacity, Policy> || instrumented;
+
 	static constexpr bool nothrow_move_constructor_requirements = (
 	// If we can't move either because move throws or isn't available, the move constructor depends on the copy constructible being nothrow, since that's what's going to be called instead,
 	// mimicking the behaviour of std::vector. 
@@ -600,149 +1510,190 @@ public:
 
 	constexpr static_vector(std::size_t count, const T& value) 
 		requires (std::is_copy_constructible_v<T>)
-		: _size(count)
+		: _size(static_cast<size_field_type>(fit(count, Capacity, "Static vector lacks the capacity for so many elements!")))
 	{
-		if (count > Capacity)
-		{
-			_size = 0;
-			throw std::runtime_error("Static vector lacks the capacity for so many elements!");
-		}
-
-		std::uninitialized_fill_n(begin(), count, value);
+		static_vector_detail::uninitialized_fill_n(begin(), _size, value);
+		note_growth();
 	}
 
 	constexpr static_vector(std::size_t count)  
 		requires (std::is_default_constructible_v<T>)
-		: _size(count)
+		: _size(static_cast<size_field_type>(fit(count, Capacity, "Static vector lacks the capacity for so many elements!")))
 	{
-		if (count > Capacity)
-		{
-			_size = 0;
-			throw std::runtime_error("Static vector lacks the capacity for so many elements!");
-		}
-
-		std::uninitialized_value_construct_n(begin(), count);
+		static_vector_detail::uninitialized_value_construct_n(begin(), _size);
+		note_growth();
 	}
 
 	template<typename Iterator> requires (std::forward_iterator<Iterator> && std::constructible_from<T, typename Iterator::value_type>)
 	constexpr static_vector(Iterator first, Iterator last) 
-		: _size(std::distance(first, last))
+		: _size(static_cast<size_field_type>(fit(static_cast<std::size_t>(std::distance(first, last)), Capacity, "Static vector lacks the capacity for so many elements!")))
 	{
-		if (std::distance(first, last) > Capacity)
-		{
-			_size = 0;
-			throw std::runtime_error("Static vector lacks the capacity for so many elements!");
-		}
-
-		std::uninitialized_copy(first, last, begin());
+		static_vector_detail::uninitialized_copy_n(first, _size, begin());
+		note_growth();
 	}
 
 	constexpr static_vector(std::initializer_list<T> values)
-		: _size(values.size())
+		: _size(static_cast<size_field_type>(fit(values.size(), Capacity, "Static vector lacks the capacity for so many elements!")))
 	{
-		if (values.size() > Capacity)
-		{
-			_size = 0;
-			throw std::runtime_error("Static vector lacks the capacity for so many elements!");
-		}
-
-		std::uninitialized_copy_n(values.begin(), values.size(), begin());
+		static_vector_detail::uninitialized_copy_n(values.begin(), _size, begin());
+		note_growth();
 	}
 
-	template <typename U> requires std::constructible_from<T, U> && !std::same_as<T, U>
+	template <typename U> requires (std::constructible_from<T, U> && !std::same_as<T, U>)
 	constexpr static_vector(std::initializer_list<U> values)
-		: _size(values.size())
+		: _size(static_cast<size_field_type>(fit(values.size(), Capacity, "Static vector lacks the capacity for so many elements!")))
+	{
+		static_vector_detail::uninitialized_copy_n(values.begin(), _size, begin());
+		note_growth();
+	}
+
+#if STATIC_VECTOR_HAS_EXECUTION
+	// The constructors above with the elements constructed under an execution policy, see the bulk operations further down.
+	// Trivial elements past the new ones are zeroed under the policy too, rather than up front by the storage.
+	template <typename Execution_Policy> requires (std::is_execution_policy_v<std::remove_cvref_t<Execution_Policy>> && std::is_default_constructible_v<T>)
+	static_vector(Execution_Policy&& execution, std::size_t count)
+		: _storage(static_vector_detail::uninitialized_storage)
 	{
-		if (values.size() > Capacity)
+		count = fit(count, Capacity, "Static vector lacks the capacity for so many elements!");
+		if (parallel_worthwhile(count))
 		{
-			_size = 0;
-			throw std::runtime_error("Static vector lacks the capacity for so many elements!");
+			std::uninitialized_value_construct_n(execution, data(), count);
 		}
-
-		std::uninitialized_copy_n(values.begin(), values.size(), begin());
+		else
+		{
+			std::uninitialized_value_construct_n(data(), count);
+		}
+		zero_tail(execution, count);
+		_size = static_cast<size_field_type>(count);
+		note_growth();
 	}
 
-	constexpr static_vector(const static_vector& other) noexcept requires (std::is_copy_constructible_v<T> && std::is_trivially_copy_constructible_v<T>) = default;
-
-	constexpr static_vector(const static_vector& other) noexcept (std::is_nothrow_copy_constructible_v<T>) requires (!std::is_trivially_copy_constructible_v<T> && std::is_copy_constructible_v<T>)
-		: _size(other.size())
+	template <typename Execution_Policy> requires (std::is_execution_policy_v<std::remove_cvref_t<Execution_Policy>> && std::is_copy_constructible_v<T>)
+	static_vector(Execution_Policy&& execution, std::size_t count, const T& value)
+		: _storage(static_vector_detail::uninitialized_storage)
 	{
-		std::uninitialized_copy_n(other.cbegin(), other.size(), begin());
+		count = fit(count, Capacity, "Static vector lacks the capacity for so many elements!");
+		if (parallel_worthwhile(count))
+		{
+			std::uninitialized_fill_n(execution, data(), count, value);
+		}
+		else
+		{
+			std::uninitialized_fill_n(data(), count, value);
+		}
+		zero_tail(execution, count);
+		_size = static_cast<size_field_type>(count);
+		note_growth();
 	}
 
-	template<std::size_t Other_Capacity> requires (std::is_copy_constructible_v<T> && (Capacity != Other_Capacity))
-	constexpr static_vector(const static_vector<T, Other_Capacity>& other) noexcept (std::is_nothrow_copy_constructible_v<T> && (Other_Capacity < Capacity))
-		: _size (other.size())
+	// A copy of other, e.g. a snapshot of a large table.
+	template <typename Execution_Policy> requires (std::is_execution_policy_v<std::remove_cvref_t<Execution_Policy>> && std::is_copy_constructible_v<T>)
+	static_vector(Execution_Policy&& execution, const static_vector& other)
+		: instrumentation_type(other), _storage(static_vector_detail::uninitialized_storage)
 	{
-		if constexpr (Other_Capacity > Capacity)
+		if (parallel_worthwhile(other.size()))
 		{
-			if (other.size() > Capacity)
-			{
-				_size = 0;
-				throw std::runtime_error("Static vector lacks the capacity to store the data of the other vector!");
-			}
+			std::uninitialized_copy_n(execution, other.data(), other.size(), data());
+		}
+		else
+		{
+			std::uninitialized_copy_n(other.data(), other.size(), data());
 		}
+		zero_tail(execution, other.size());
+		_size = other._size;
+		instrumentation_type::copied();
+		note_growth();
+	}
+#endif
+
+	constexpr static_vector(const static_vector& other) noexcept requires (std::is_copy_constructible_v<T> && std::is_trivially_copy_constructible_v<T> && !live_prefix_copy) = default;
+
+	constexpr static_vector(const static_vector& other) noexcept (std::is_nothrow_copy_constructible_v<T>) requires ((!std::is_trivially_copy_constructible_v<T> || live_prefix_copy) && std::is_copy_constructible_v<T>)
+		: instrumentation_type(other), _storage(static_vector_detail::uninitialized_storage), _size(static_cast<size_field_type>(other.size()))
+	{
+		static_vector_detail::uninitialized_copy_n(other.data(), other.size(), data());
+		zero_constant_tail(other.size());
+		instrumentation_type::copied();
+		note_growth();
+	}
 
-		std::uninitialized_copy_n(other.cbegin(), other.size(), begin()); 
+	template<std::size_t Other_Capacity> requires (std::is_copy_constructible_v<T> && (Capacity != Other_Capacity))
+	constexpr static_vector(const static_vector<T, Other_Capacity, Policy>& other) noexcept (std::is_nothrow_copy_constructible_v<T> && (Other_Capacity < Capacity || Policy::is_nothrow))
+		: _size(static_cast<size_field_type>(Other_Capacity > Capacity ? fit(other.size(), Capacity, "Static vector lacks the capacity to store the data of the other vector!") : other.size()))
+	{
+		static_vector_detail::uninitialized_copy_n(other.cbegin(), _size, begin());
+		note_growth();
 	}
 
-	constexpr static_vector(static_vector&& other) noexcept requires (std::is_trivially_move_constructible_v<T> && std::is_move_constructible_v<T>) = default;
+	constexpr static_vector(static_vector&& other) noexcept requires (std::is_trivially_move_constructible_v<T> && std::is_move_constructible_v<T> && !live_prefix_copy) = default;
 
-	constexpr static_vector(static_vector&& other) noexcept (nothrow_move_constructor_requirements) requires (!std::is_trivially_move_constructible_v<T> && (std::is_move_constructible_v<T> || std::is_copy_constructible_v<T>))
-		: _size (other.size())
+	constexpr static_vector(static_vector&& other) noexcept (nothrow_move_constructor_requirements || is_trivially_relocatable_v<T>) requires ((!std::is_trivially_move_constructible_v<T> || live_prefix_copy) && (std::is_move_constructible_v<T> || std::is_copy_constructible_v<T>))
+		: instrumentation_type(other), _storage(static_vector_detail::uninitialized_storage), _size(static_cast<size_field_type>(other.size()))
 	{
-		if constexpr ((std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) && std::is_move_constructible_v<T>)
+		zero_constant_tail(other.size());
+		if constexpr (std::is_trivially_move_constructible_v<T>)
+		{
+			// Moving leaves other as it was, like the defaulted move would.
+			static_vector_detail::uninitialized_copy_n(other.data(), other.size(), data());
+		}
+		else if constexpr (is_trivially_relocatable_v<T>)
+		{
+			static_vector_detail::relocate_n(other.data(), other.size(), data());
+			other._size = 0;
+		}
+		else if constexpr ((std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) && std::is_move_constructible_v<T>)
 		{
-			std::uninitialized_move_n(other.begin(), other.size(), begin());
+			static_vector_detail::uninitialized_move_n(other.begin(), other.size(), begin());
+			other.clear();
 		}
 		else
 		{
-			std::uninitialized_copy_n(other.begin(), other.size(), begin());
+			static_vector_detail::uninitialized_copy_n(other.begin(), other.size(), begin());
+			other.clear();
 		}
-
-		other.clear();
+		instrumentation_type::moved();
+		note_growth();
 	}
 
 	template<std::size_t Other_Capacity> requires ((std::is_move_constructible_v<T> || std::is_copy_constructible_v<T>) && (Capacity != Other_Capacity))
-		constexpr static_vector(static_vector<T, Other_Capacity>&& other) noexcept (nothrow_move_constructor_requirements&& Capacity > Other_Capacity)
-		: _size(other.size())
+		constexpr static_vector(static_vector<T, Other_Capacity, Policy>&& other) noexcept ((nothrow_move_constructor_requirements || is_trivially_relocatable_v<T>) && (Capacity > Other_Capacity || Policy::is_nothrow))
+		: _size(static_cast<size_field_type>(Other_Capacity > Capacity ? fit(other.size(), Capacity, "Static vector lacks the capacity to store the data of the other vector!") : other.size()))
 	{
-		if constexpr (Other_Capacity > Capacity)
+		if constexpr (is_trivially_relocatable_v<T>)
 		{
-			if (other.size() > Capacity)
-			{
-				_size = 0;
-				throw std::runtime_error("Static vector lacks the capacity to store the data of the other vector!");
-			}
+			static_vector_detail::relocate_n(other.data(), _size, data());
+			// Only left over if the policy let us drop what didn't fit.
+			std::destroy(other.begin() + _size, other.end());
+			other._size = 0;
 		}
-
-		if constexpr ((std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) && std::is_move_constructible_v<T>)
+		else if constexpr ((std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) && std::is_move_constructible_v<T>)
 		{
-			std::uninitialized_move_n(other.begin(), other.size(), begin());
+			static_vector_detail::uninitialized_move_n(other.begin(), _size, begin());
+			other.clear();
 		}
 		else
 		{
-			std::uninitialized_copy_n(other.begin(), other.size(), begin());
+			static_vector_detail::uninitialized_copy_n(other.begin(), _size, begin());
+			other.clear();
 		}
-
-		other.clear();
+		note_growth();
 	}
 
-	constexpr static_vector& operator=(const static_vector& other) noexcept requires (std::is_trivially_copyable_v<T> && std::is_copy_constructible_v<T>&& std::is_copy_assignable_v<T>) = default;
+	constexpr static_vector& operator=(const static_vector& other) noexcept requires (std::is_trivially_copyable_v<T> && std::is_copy_constructible_v<T>&& std::is_copy_assignable_v<T> && !live_prefix_copy) = default;
 
 	constexpr static_vector& operator= (const static_vector& other) noexcept (std::is_nothrow_copy_constructible_v<T>&& std::is_nothrow_copy_assignable_v<T>&& std::is_nothrow_destructible_v<T>) 
-		requires (!std::is_trivially_copyable_v<T> && std::is_copy_constructible_v<T>&& std::is_copy_assignable_v<T>)
+		requires ((!std::is_trivially_copyable_v<T> || live_prefix_copy) && std::is_copy_constructible_v<T>&& std::is_copy_assignable_v<T>)
 	{
 		if constexpr (std::is_trivially_copyable_v<T>)
 		{
-			std::copy_n(other.cbegin(), other.size(), begin());
+			std::copy_n(other.data(), other.size(), data());
 		}
 		else
 		{
 			if (_size <= other.size())
 			{
 				std::copy_n(other.cbegin(), _size, begin());
-				std::uninitialized_copy_n(other.cbegin() + _size, other.size() - _size, begin() + _size);
+				static_vector_detail::uninitialized_copy_n(other.cbegin() + _size, other.size() - _size, begin() + _size);
 			}
 			else
 			{
@@ -754,59 +1705,74 @@ public:
 			}
 		}
 
-		_size = other.size();
+		_size = static_cast<size_field_type>(other.size());
+		instrumentation_type::copied();
+		note_growth();
 
 		return *this;
 	}
 
 	template<std::size_t Other_Capacity> requires (std::copy_constructible<T> && std::is_copy_assignable_v<T> && (Capacity != Other_Capacity))
-	constexpr static_vector& operator= (const static_vector<T, Other_Capacity>& other) noexcept (std::is_nothrow_copy_constructible_v<T> && std::is_nothrow_copy_assignable_v<T> && std::is_nothrow_destructible_v<T> && (Other_Capacity < Capacity))
+	constexpr static_vector& operator= (const static_vector<T, Other_Capacity, Policy>& other) noexcept (std::is_nothrow_copy_constructible_v<T> && std::is_nothrow_copy_assignable_v<T> && std::is_nothrow_destructible_v<T> && (Other_Capacity < Capacity || Policy::is_nothrow))
 	{
-		if constexpr (Other_Capacity > Capacity)
-		{
-			if (other.size() > Capacity)
-			{
-				throw std::runtime_error("Static vector lacks the capacity to store the data of the other vector!");
-			}
-		}
+		const std::size_t count = Other_Capacity > Capacity ? fit(other.size(), Capacity, "Static vector lacks the capacity to store the data of the other vector!") : other.size();
 
 		if constexpr (std::is_trivially_copyable_v<T>)
 		{
-			std::copy_n(other.cbegin(), other.size(), begin());
+			std::copy_n(other.cbegin(), count, begin());
 		}
 		else
 		{
-			if (_size <= other.size())
+			if (_size <= count)
 			{
 				std::copy_n(other.cbegin(), _size, begin());
-				std::uninitialized_copy_n(other.cbegin() + _size, other.size() - _size, begin() + _size);
+				static_vector_detail::uninitialized_copy_n(other.cbegin() + _size, count - _size, begin() + _size);
 			}
 			else
 			{
-				std::copy_n(other.cbegin(), other.size(), begin());
+				std::copy_n(other.cbegin(), count, begin());
 				if constexpr (!std::is_trivially_destructible_v<T>)
 				{
-					std::destroy_n(begin() + other.size(), _size - other.size());
+					std::destroy_n(begin() + count, _size - count);
 				}
 			}
 		}
 
-		_size = other.size();
+		_size = static_cast<size_field_type>(count);
+		note_growth();
 
 		return *this;
 	}
  
-	constexpr static_vector& operator=(static_vector&& other) noexcept requires (std::is_trivially_move_assignable_v<T> && std::is_move_assignable_v<T> && std::is_trivially_move_assignable_v<T>) = default;
+	constexpr static_vector& operator=(static_vector&& other) noexcept requires (std::is_trivially_move_assignable_v<T> && std::is_move_assignable_v<T> && std::is_trivially_move_assignable_v<T> && !live_prefix_copy) = default;
 
-	constexpr static_vector& operator=(static_vector&& other) noexcept (nothrow_move_assignment_requirements) requires (!std::is_trivially_move_assignable_v<T> && ((std::is_copy_constructible_v<T>&& std::is_copy_assignable_v<T>) || (std::is_move_constructible_v<T> && std::is_move_assignable_v<T>)))
+	constexpr static_vector& operator=(static_vector&& other) noexcept (nothrow_move_assignment_requirements) requires ((!std::is_trivially_move_assignable_v<T> || live_prefix_copy) && ((std::is_copy_constructible_v<T>&& std::is_copy_assignable_v<T>) || (std::is_move_constructible_v<T> && std::is_move_assignable_v<T>)))
 	{
 		if (this == &other)
 		{
 			return *this;
 		}
 
+		if constexpr (std::is_trivially_copyable_v<T>)
+		{
+			std::copy_n(other.data(), other.size(), data());
+			_size = other._size;
+			instrumentation_type::moved();
+			note_growth();
+			return *this;
+		}
+		else if constexpr (is_trivially_relocatable_v<T>)
+		{
+			clear();
+			static_vector_detail::relocate_n(other.data(), other.size(), data());
+			_size = other._size;
+			other._size = 0;
+			instrumentation_type::moved();
+			note_growth();
+			return *this;
+		}
 		// If T isn't both move_constructible_and_move_assignable or if they aren't nothrow, we'll just do a copy
-		if constexpr (!both_move_constructible_and_move_assignable || !is_both_nothrow_move_constructible_and_move_assignable)
+		else if constexpr (!both_move_constructible_and_move_assignable || !is_both_nothrow_move_constructible_and_move_assignable)
 		{
 			(*this) = other;
 			other.clear();
@@ -817,7 +1783,7 @@ public:
 			if (_size <= other.size())
 			{
 				std::copy_n(std::make_move_iterator(other.begin()), _size, begin());
-				std::uninitialized_move_n(other.begin() + _size, other.size() - _size, begin() + _size);
+				static_vector_detail::uninitialized_move_n(other.begin() + _size, other.size() - _size, begin() + _size);
 			}
 			else
 			{
@@ -828,56 +1794,65 @@ public:
 				}
 			}
 
-			_size = other.size();
+			_size = static_cast<size_field_type>(other.size());
 			other.clear();
+			instrumentation_type::moved();
+			note_growth();
 
 			return *this;
 		}
 	}
 
 	template<std::size_t Other_Capacity> requires ((std::copy_constructible<T>&& std::is_copy_assignable_v<T>) || (std::move_constructible<T> && std::is_move_assignable_v<T>) && (Capacity != Other_Capacity))
-	constexpr static_vector& operator= (static_vector<T, Other_Capacity>&& other) noexcept (nothrow_move_assignment_requirements && (Other_Capacity < Capacity))
+	constexpr static_vector& operator= (static_vector<T, Other_Capacity, Policy>&& other) noexcept (nothrow_move_assignment_requirements && (Other_Capacity < Capacity || Policy::is_nothrow))
 	{
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			const std::size_t count = Other_Capacity > Capacity ? fit(other.size(), Capacity, "Static vector lacks the capacity to store the data of the other vector!") : other.size();
+
+			clear();
+			static_vector_detail::relocate_n(other.data(), count, data());
+			std::destroy(other.begin() + count, other.end());
+			_size = static_cast<size_field_type>(count);
+			other._size = 0;
+			note_growth();
+			return *this;
+		}
 		// If T isn't both move_constructible_and_move_assignable or if they aren't nothrow, we'll just do a copy
-		if constexpr (!both_move_constructible_and_move_assignable || !is_both_nothrow_move_constructible_and_move_assignable)
+		else if constexpr (!both_move_constructible_and_move_assignable || !is_both_nothrow_move_constructible_and_move_assignable)
 		{
-			(*this) = other; // This line does nothing?
+			(*this) = other;
 			other.clear();
 			return *this;
 		}
 		else
 		{
-			if constexpr (Other_Capacity > Capacity)
-			{
-				if (other.size() > Capacity)
-				{
-					throw std::runtime_error("Static vector lacks the capacity to store the data of the other vector!");
-				}
-			}
+			const std::size_t count = Other_Capacity > Capacity ? fit(other.size(), Capacity, "Static vector lacks the capacity to store the data of the other vector!") : other.size();
 
 			if constexpr (std::is_trivially_move_assignable_v<T>)
 			{
-				std::copy_n(std::make_move_iterator(other.begin()), other.size(), begin());
+				std::copy_n(std::make_move_iterator(other.begin()), count, begin());
 			}
 			else
 			{
-				if (_size <= other.size())
+				if (_size <= count)
 				{
 					std::copy_n(std::make_move_iterator(other.begin()), _size, begin());
-					std::uninitialized_move_n(other.begin() + _size, other.size() - _size, begin() + _size);
+					static_vector_detail::uninitialized_move_n(other.begin() + _size, count - _size, begin() + _size);
 				}
 				else
 				{
-					std::copy_n(std::make_move_iterator(other.begin()), other.size(), begin());
+					std::copy_n(std::make_move_iterator(other.begin()), count, begin());
 					if constexpr (!std::is_trivially_destructible_v<T>)
 					{
-						std::destroy_n(begin() + other.size(), _size - other.size());
+						std::destroy_n(begin() + count, _size - count);
 					}
 				}
 			}
 
-			_size = other.size();
+			_size = static_cast<size_field_type>(count);
 			other.clear();
+			note_growth();
 
 			return *this;
 		}
@@ -886,12 +1861,7 @@ public:
 	template <typename U> requires (std::constructible_from<T, U> && std::is_copy_assignable_v<T> && std::copy_constructible<T>)
 	constexpr static_vector& operator=(std::initializer_list<U> values)
 	{
-		const auto count = values.size();
-
-		if (count > Capacity)
-		{
-			throw std::runtime_error("Static vector lacks the capacity for so many elements!");
-		}
+		const std::size_t count = fit(values.size(), Capacity, "Static vector lacks the capacity for so many elements!");
 
 		if constexpr (std::is_trivially_copyable_v<T>)
 		{
@@ -902,7 +1872,7 @@ public:
 			if (_size <= count)
 			{
 				std::copy_n(values.begin(), _size, begin());
-				std::uninitialized_copy_n(values.begin() + _size, count - _size, begin() + _size);
+				static_vector_detail::uninitialized_copy_n(values.begin() + _size, count - _size, begin() + _size);
 			}
 			else
 			{
@@ -914,7 +1884,8 @@ public:
 			}
 		}
 
-		_size = count;
+		_size = static_cast<size_field_type>(count);
+		note_growth();
 
 		return *this;
 	}
@@ -922,12 +1893,7 @@ public:
 	template <typename U> requires (std::is_constructible_v<T, U> && std::is_copy_assignable_v<T>&& std::is_copy_constructible_v<T>)
 	constexpr void assign(std::initializer_list<U> values)
 	{
-		const auto count = values.size();
-
-		if (count > Capacity)
-		{
-			throw std::runtime_error("Static vector lacks the capacity for so many elements!");
-		}
+		const std::size_t count = fit(values.size(), Capacity, "Static vector lacks the capacity for so many elements!");
 
 		if constexpr (std::is_trivially_copyable_v<T>)
 		{
@@ -938,7 +1904,7 @@ public:
 			if (_size <= count)
 			{
 				std::copy_n(values.begin(), _size, begin());
-				std::uninitialized_copy_n(values.begin() + _size, count - _size, begin() + _size);
+				static_vector_detail::uninitialized_copy_n(values.begin() + _size, count - _size, begin() + _size);
 			}
 			else
 			{
@@ -950,15 +1916,13 @@ public:
 			}
 		}
 
-		_size = count;
+		_size = static_cast<size_field_type>(count);
+		note_growth();
 	}
 
 	constexpr void assign(std::size_t count, const T& value)
 	{
-		if (count > Capacity)
-		{
-			throw std::runtime_error("Static vector lacks the capacity for so many elements!");
-		}
+		count = fit(count, Capacity, "Static vector lacks the capacity for so many elements!");
 
 		if constexpr (std::is_trivially_copyable_v<T>)
 		{
@@ -968,8 +1932,8 @@ public:
 		{
 			if (_size <= count)
 			{
-				std::fill_n(begin(), count, value);
-				std::uninitialized_fill_n(begin() + _size, count - _size, value);
+				std::fill_n(begin(), _size, value);
+				static_vector_detail::uninitialized_fill_n(begin() + _size, count - _size, value);
 			}
 			else
 			{
@@ -981,18 +1945,14 @@ public:
 			}
 		}
 
-		_size = count;
+		_size = static_cast<size_field_type>(count);
+		note_growth();
 	}
 
 	template <typename Iterator> requires (std::forward_iterator<Iterator> && std::is_convertible_v<typename std::iterator_traits<Iterator>::value_type, T>)
 	constexpr void assign(Iterator first, Iterator last)
 	{
-		const auto new_size = static_cast<size_t>(std::distance(first, last));
-
-		if (new_size > Capacity)
-		{
-			throw std::runtime_error("Static vector lacks the capacity for so many elements!");
-		}
+		const std::size_t new_size = fit(static_cast<std::size_t>(std::distance(first, last)), Capacity, "Static vector lacks the capacity for so many elements!");
 
 		if (new_size < _size)
 		{
@@ -1003,12 +1963,12 @@ public:
 				std::destroy_n(begin() + new_size, _size - new_size);
 			}
 
-			_size = new_size;
+			_size = static_cast<size_field_type>(new_size);
 		}
 		else if (new_size == _size)
 		{
 			std::copy_n(first, new_size, begin());
-			_size = new_size;
+			_size = static_cast<size_field_type>(new_size);
 		}
 		else
 		{
@@ -1019,419 +1979,1311 @@ public:
 				++it;
 				++first;
 			}
-			std::uninitialized_copy(first, last, it);
-			_size = new_size;
+			static_vector_detail::uninitialized_copy_n(first, new_size - _size, it);
+			_size = static_cast<size_field_type>(new_size);
+			note_growth();
 		}
 	}
 
-	constexpr void swap(static_vector& other) noexcept(std::is_nothrow_swappable_v<T> && ((!std::is_move_constructible_v<T>&& std::is_nothrow_copy_constructible_v<T>) || std::is_nothrow_move_constructible_v<T>))
+	constexpr void swap(static_vector& other) noexcept (nothrow_swappable)
 		requires (std::is_swappable_v<T> && (std::is_copy_constructible_v<T> || std::is_move_constructible_v<T>))
 	{
-		::swap(*this, other);
+		if (this == &other)
+		{
+			return;
+		}
+
+		swap_elements(data(), _size, other.data(), other._size);
+		std::swap(_size, other._size);
+		note_growth();
+		other.note_growth();
 	}
 
 	template <size_t Other_Capacity> requires (Capacity != Other_Capacity && std::is_swappable_v<T> && (std::is_copy_constructible_v<T> || std::is_move_constructible_v<T>))
-	constexpr void swap(static_vector<T, Other_Capacity>& other) 
-		noexcept (std::is_nothrow_swappable_v<T> && ((!std::is_move_constructible_v<T> && std::is_nothrow_copy_constructible_v<T>) || std::is_nothrow_move_constructible_v<T>))
+	constexpr void swap(static_vector<T, Other_Capacity, Policy>& other) noexcept (nothrow_swappable && Policy::is_nothrow)
 	{
+		// Nothing sensible can be dropped from a swap, if the policy lets us go on the swap just doesn't happen.
 		if constexpr (Other_Capacity > Capacity)
 		{
-			if (other.size() > Capacity)
+			if (other.size() > Capacity) [[unlikely]]
 			{
-				throw std::runtime_error("Static vector lacks the capacity for so many elements!");
+				capacity_exceeded("Static vector lacks the capacity for so many elements!");
+				return;
 			}
 		}
 		else if constexpr (Other_Capacity < Capacity)
 		{
-			if (size() > Other_Capacity)
+			if (size() > Other_Capacity) [[unlikely]]
 			{
-				throw std::runtime_error("Static vector lacks the capacity for so many elements!");
+				capacity_exceeded("Static vector lacks the capacity for so many elements!");
+				return;
 			}
 		}
 
-		auto this_it = begin();
-		auto other_it = other.begin();
+		swap_elements(data(), _size, other.data(), other._size);
 
-		for (; this_it != end() && other_it != other.end(); ++this_it, ++other_it)
+		// The two vectors may store their sizes in different types.
+		const std::size_t this_size = _size;
+		_size = static_cast<size_field_type>(other._size);
+		other._size = static_cast<typename static_vector<T, Other_Capacity, Policy>::size_field_type>(this_size);
+		note_growth();
+		other.note_growth();
+	}
+
+	constexpr reference operator[] (std::size_t index) noexcept(!Policy::checks_indexing || Policy::is_nothrow)
+	{
+		if constexpr (Policy::checks_indexing)
 		{
-			std::swap(*this_it, *other_it);
+			if (index >= _size) [[unlikely]]
+			{
+				Policy::out_of_range("Index out of bounds!");
+			}
 		}
 
-		if (this_it != end())
+		return _storage.elements[index];
+	}
+
+	constexpr const_reference operator[] (std::size_t index) const noexcept(!Policy::checks_indexing || Policy::is_nothrow)
+	{
+		if constexpr (Policy::checks_indexing)
 		{
-			if constexpr (std::is_move_constructible_v<T>)
+			if (index >= _size) [[unlikely]]
+			{
+				Policy::out_of_range("Index out of bounds!");
+			}
+		}
+
+		return _storage.elements[index];
+	}
+
+	constexpr reference at(std::size_t index) 
+	{
+		if (index >= _size) [[unlikely]]
+		{
+			Policy::out_of_range("Index out of bounds!");
+		}
+
+		return _storage.elements[index];
+	}
+
+	constexpr const_reference at(std::size_t index) const 
+	{
+		if (index >= _size) [[unlikely]]
+		{
+			Policy::out_of_range("Index out of bounds!");
+		}
+
+		return _storage.elements[index];
+	}
+
+	constexpr void push_back(const T& val)
+	{
+		if (_size == Capacity) [[unlikely]]
+		{
+			capacity_exceeded("Vector is at full capacity, push back not allowed!");
+			return;
+		}
+
+		std::construct_at(std::to_address(end()), val);
+		_size++;
+		note_growth();
+	}
+
+	constexpr void push_back(T&& val)
+	{
+		if (_size == Capacity) [[unlikely]]
+		{
+			capacity_exceeded("Vector is at full capacity, push back not allowed!");
+			return;
+		}
+
+		std::construct_at(std::to_address(end()), std::forward<T>(val));
+		_size++;
+		note_growth();
+	}
+
+	// Popping from an empty vector is a bad access, reported to Policy::out_of_range (std::out_of_range with the throwing policy).
+	constexpr void pop_back() 
+	{
+		if (empty()) [[unlikely]]
+		{
+			Policy::out_of_range("Can't pop from empty vector!");
+		}
+
+		if constexpr (!std::is_trivially_destructible_v<T>)
+		{
+			std::destroy_at(_storage.elements + _size - 1);
+		}
+
+		_size--;
+	}
+
+	// Removes the last count elements, with a single call to destroy_n.
+	constexpr void pop_back(std::size_t count) noexcept (std::is_nothrow_destructible_v<T> && Policy::is_nothrow)
+	{
+		if (count > _size) [[unlikely]]
+		{
+			Policy::out_of_range("Can't pop more elements than the vector holds!");
+		}
+
+		truncate(_size - count);
+	}
+
+	// Shrinks the vector to its first count elements, does nothing if it isn't larger than that.
+	constexpr void truncate(std::size_t count) noexcept (std::is_nothrow_destructible_v<T>)
+	{
+		if (count < _size)
+		{
+			if constexpr (!std::is_trivially_destructible_v<T>)
+			{
+				std::destroy_n(begin() + count, _size - count);
+			}
+
+			_size = static_cast<size_field_type>(count);
+		}
+	}
+
+	template <typename ... Args>
+	constexpr void emplace_back(Args&& ... args)
+	{
+		if (_size == Capacity) [[unlikely]]
+		{
+			capacity_exceeded("Vector is at full capacity, push back not allowed!");
+			return;
+		}
+
+		std::construct_at(std::to_address(end()), std::forward<Args>(args)...);
+		_size++;
+		note_growth();
+	}
+
+	// Appends a new element if there is room for it, returning a pointer to it, or nullptr if the vector is full.
+	constexpr pointer try_push_back(const T& val) noexcept(std::is_nothrow_copy_constructible_v<T>)
+	{
+		return try_emplace_back(val);
+	}
+
+	constexpr pointer try_push_back(T&& val) noexcept(std::is_nothrow_move_constructible_v<T>)
+	{
+		return try_emplace_back(std::move(val));
+	}
+
+	template <typename ... Args>
+	constexpr pointer try_emplace_back(Args&& ... args) noexcept(std::is_nothrow_constructible_v<T, Args...>)
+	{
+		if (_size == Capacity)
+		{
+			instrumentation_type::overflowed();
+			return nullptr;
+		}
+
+		return std::addressof(unchecked_emplace_back(std::forward<Args>(args)...));
+	}
+
+	// Appends a new element without checking the capacity, the caller must make sure that size() < capacity().
+	// The capacity is only checked when STATIC_VECTOR_DEBUGGING is set, so otherwise this is just the construction and the size increment.
+	constexpr reference unchecked_push_back(const T& val) noexcept(std::is_nothrow_copy_constructible_v<T>)
+	{
+		return unchecked_emplace_back(val);
+	}
+
+	constexpr reference unchecked_push_back(T&& val) noexcept(std::is_nothrow_move_constructible_v<T>)
+	{
+		return unchecked_emplace_back(std::move(val));
+	}
+
+	template <typename ... Args>
+	constexpr reference unchecked_emplace_back(Args&& ... args) noexcept(std::is_nothrow_constructible_v<T, Args...>)
+	{
+		static_vector_detail::debug_check(_size < Capacity, "unchecked_emplace_back on a full static_vector");
+
+		T* const element = std::construct_at(std::to_address(end()), std::forward<Args>(args)...);
+		_size++;
+		note_growth();
+
+		return *element;
+	}
+
+	constexpr void clear() noexcept (std::is_nothrow_destructible_v<T>)
+	{
+		if constexpr (std::is_trivially_destructible_v<T>)
+		{
+			_size = 0;
+		}
+		else
+		{
+			if constexpr (std::is_nothrow_destructible_v<T>)
 			{
-				std::uninitialized_move(this_it, end(), other.end());
+				std::destroy_n(begin(), size());
+				_size = 0;
 			}
 			else
 			{
-				std::uninitialized_copy(this_it, end(), other.end());
+				while (!empty())
+				{
+					pop_back();
+				}
 			}
-			if constexpr (!std::is_trivially_destructible_v<T>)
+		}
+	}
+
+	// Should constructing or moving an element throw, insertions leak nothing and leave the size as it was. Trivially relocatable
+	// elements are left as they were, and so are others when a single pass range fails to construct one of its elements. Otherwise
+	// the elements from pos on are left valid but unspecified.
+	template <typename ... Args>
+	constexpr iterator emplace(const_iterator pos, Args&& ... args)
+	{
+		if (_size == Capacity) [[unlikely]]
+		{
+			capacity_exceeded("Vector is at full capacity, insertion not allowed!");
+			return to_mutable(pos);
+		}
+
+		const iterator position = to_mutable(pos);
+
+		if (position == end())
+		{
+			std::construct_at(std::to_address(end()), std::forward<Args>(args)...);
+			_size++;
+			note_growth();
+			return position;
+		}
+
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			instrumentation_type::shifted(static_cast<std::size_t>(end() - position));
+
+			if (std::is_constant_evaluated())
 			{
-				std::destroy_n(this_it, std::distance(this_it, end() - 1));
+				// Raw scratch storage isn't usable in constant expressions, the new element is built as a local and moved in instead.
+				T value(std::forward<Args>(args)...);
+
+				static_vector_detail::relocate_n(std::to_address(position), static_cast<std::size_t>(end() - position), std::to_address(position) + 1);
+				std::construct_at(std::to_address(position), std::move(value));
+			}
+			else
+			{
+				// Build the new element in scratch storage (the arguments might refer to an element we're about to shift),
+				// then relocate the tail and the new element into place without any moves.
+				std::aligned_storage_t<sizeof(T), alignof(T)> scratch;
+				T* const value = std::construct_at(reinterpret_cast<T*>(&scratch), std::forward<Args>(args)...);
+
+				static_vector_detail::relocate_n(std::to_address(position), static_cast<std::size_t>(end() - position), std::to_address(position) + 1);
+				static_vector_detail::relocate_n(value, 1, std::to_address(position));
 			}
 		}
-		if (other_it != other.end())
+		else
 		{
-			if constexpr (std::is_move_constructible_v<T>)
+			// Build the new element first, the arguments might refer to an element we're about to shift.
+			T value(std::forward<Args>(args)...);
+
+			gap_guard guard{ *this, static_cast<std::size_t>(position - begin()), 1 };
+			guard.open();
+			*position = std::move(value);
+			guard.filled = true;
+		}
+
+		_size++;
+		note_growth();
+
+		return position;
+	}
+
+	constexpr iterator insert(const_iterator pos, const T& value)
+	{
+		return emplace(pos, value);
+	}
+
+	constexpr iterator insert(const_iterator pos, T&& value)
+	{
+		return emplace(pos, std::move(value));
+	}
+
+	constexpr iterator insert(const_iterator pos, std::size_t count, const T& value)
+	{
+		count = fit(count, Capacity - _size, "Static vector lacks the capacity for so many elements!");
+
+		const std::size_t index = static_cast<std::size_t>(pos - cbegin());
+
+		if (count == 0)
+		{
+			return begin() + index;
+		}
+
+		// value might be one of our own elements
+		const T copy = value;
+		gap_guard guard{ *this, index, count };
+		const std::size_t live = guard.open();
+		const iterator position = begin() + index;
+
+		std::fill_n(position, live, copy);
+		static_vector_detail::uninitialized_fill_n(position + live, count - live, copy);
+		guard.filled = true;
+
+		_size += static_cast<size_field_type>(count);
+		note_growth();
+
+		return position;
+	}
+
+	template <typename Iterator> requires (std::forward_iterator<Iterator> && std::constructible_from<T, std::iter_reference_t<Iterator>>)
+	constexpr iterator insert(const_iterator pos, Iterator first, Iterator last)
+	{
+		return insert_counted(static_cast<std::size_t>(pos - cbegin()), first, static_cast<std::size_t>(std::distance(first, last)));
+	}
+
+	template <typename Iterator> requires (std::input_iterator<Iterator> && !std::forward_iterator<Iterator> && std::constructible_from<T, std::iter_reference_t<Iterator>>)
+	constexpr iterator insert(const_iterator pos, Iterator first, Iterator last)
+	{
+		return insert_single_pass(static_cast<std::size_t>(pos - cbegin()), first, last);
+	}
+
+	constexpr iterator insert(const_iterator pos, std::initializer_list<T> values)
+	{
+		return insert_counted(static_cast<std::size_t>(pos - cbegin()), values.begin(), values.size());
+	}
+
+	template <std::ranges::input_range Range> requires (std::constructible_from<T, std::ranges::range_reference_t<Range>>)
+	constexpr iterator insert_range(const_iterator pos, Range&& range)
+	{
+		const std::size_t index = static_cast<std::size_t>(pos - cbegin());
+
+		if constexpr (std::ranges::forward_range<Range>)
+		{
+			return insert_counted(index, std::ranges::begin(range), static_cast<std::size_t>(std::ranges::distance(range)));
+		}
+		else
+		{
+			return insert_single_pass(index, std::ranges::begin(range), std::ranges::end(range));
+		}
+	}
+
+	template <std::ranges::input_range Range> requires (std::constructible_from<T, std::ranges::range_reference_t<Range>>)
+	constexpr void append_range(Range&& range)
+	{
+		insert_range(cend(), std::forward<Range>(range));
+	}
+
+	constexpr iterator erase(const_iterator pos) noexcept((std::is_nothrow_move_assignable_v<T> || is_trivially_relocatable_v<T>) && std::is_nothrow_destructible_v<T>)
+	{
+		return erase_n(static_cast<std::size_t>(pos - cbegin()), 1);
+	}
+
+	// Erases the elements in [from, to), like the standard containers.
+	constexpr iterator erase(const_iterator from, const_iterator to) noexcept((std::is_nothrow_move_assignable_v<T> || is_trivially_relocatable_v<T>) && std::is_nothrow_destructible_v<T>)
+	{
+		return erase_n(static_cast<std::size_t>(from - cbegin()), static_cast<std::size_t>(to - from));
+	}
+
+	// Erases the element at pos in O(1) by moving the last element into its place, so the order of the elements isn't preserved.
+	// Returns an iterator to the element that took pos' place, or end() if pos was the last element.
+	constexpr iterator erase_unordered(const_iterator pos) noexcept((std::is_nothrow_move_assignable_v<T> || is_trivially_relocatable_v<T>) && std::is_nothrow_destructible_v<T>)
+	{
+		const iterator position = to_mutable(pos);
+		T* const last = data() + _size - 1;
+
+		if (std::to_address(position) != last)
+		{
+			if constexpr (is_trivially_relocatable_v<T>)
 			{
-				std::uninitialized_move(other_it, other.end(), end());
+				std::destroy_at(std::to_address(position));
+				static_vector_detail::relocate_n(last, 1, std::to_address(position));
+				_size--;
+				return position;
 			}
 			else
 			{
-				std::uninitialized_copy(other_it, other.end(), end());
+				*position = std::move(*last);
 			}
+		}
+
+		std::destroy_at(last);
+		_size--;
+
+		return position;
+	}
+
+	// Moves every element into destination, whose previous contents are destroyed, and leaves this vector empty.
+	// For trivially relocatable types this is a single memcpy, with no element moved or destroyed one by one.
+	template <std::size_t Other_Capacity>
+	constexpr void relocate_to(static_vector<T, Other_Capacity, Policy>& destination) noexcept ((is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>) && std::is_nothrow_destructible_v<T> && (Other_Capacity >= Capacity || Policy::is_nothrow))
+		requires (std::is_move_constructible_v<T>)
+	{
+		if (static_cast<const void*>(std::addressof(destination)) == static_cast<const void*>(this))
+		{
+			return;
+		}
+
+		const std::size_t count = Other_Capacity < Capacity ? fit(_size, Other_Capacity, "Static vector lacks the capacity to store the data of the other vector!") : _size;
+
+		destination.clear();
+
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			static_vector_detail::relocate_n(data(), count, destination.data());
+			std::destroy(begin() + count, end());
+		}
+		else
+		{
+			static_vector_detail::uninitialized_move_n(begin(), count, destination.begin());
+			std::destroy_n(begin(), size());
+		}
+
+		destination._size = static_cast<typename static_vector<T, Other_Capacity, Policy>::size_field_type>(count);
+		_size = 0;
+		destination.note_growth();
+	}
+
+	// Returns a vector holding all the elements of this one, which is left empty.
+	constexpr static_vector take() noexcept ((is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>) && std::is_nothrow_destructible_v<T>)
+		requires (std::is_move_constructible_v<T>)
+	{
+		static_vector result;
+		relocate_to(result);
+		return result;
+	}
+
+	// If T is trivially_destructible, static_vector<T> should be too.
+	// To get trivial destructibility, a class needs to default ~static_vector
+	// Use a requires clause to select the right version (default vs destroy_n)
+	//
+	// Citation--https://en.cppreference.com/w/cpp/language/destructor#Trivial_destructor
+	// See also
+	// - https://www.sandordargo.com/blog/2021/06/16/multiple-destructors-with-cpp-concepts
+	// - Sy Brand's talk "How to write well-behaved value wrappers",
+	//    https://youtu.be/sQcPte0JNmE?t=1147
+	//
+	// Unfortunately, this won't work on clang yet
+	constexpr ~static_vector() noexcept requires (std::is_trivially_destructible_v<T>) = default;
+	constexpr ~static_vector() noexcept (std::is_nothrow_destructible_v<T>)
+		requires(!std::is_trivially_destructible_v<T>)
+	{
+		std::destroy_n(begin(), _size);
+	}
+
+	constexpr std::size_t size() const noexcept
+	{
+		return _size;
+	}
+
+	// The largest size this vector has had, tracked when its policy instruments it, see static_vector_instrumentation.hpp.
+	constexpr std::size_t peak_size() const noexcept requires (instrumented)
+	{
+		return instrumentation_type::peak();
+	}
+
+	constexpr void resize(std::size_t new_size) noexcept (std::is_nothrow_default_constructible_v<T> && std::is_nothrow_destructible_v<T> && Policy::is_nothrow)
+	{
+		new_size = fit(new_size, Capacity, "Can't resize beyond capacity!");
+
+		if (new_size > _size)
+		{
+			static_vector_detail::uninitialized_value_construct_n(end(), new_size - _size);
+		}
+		else
+		{
 			if constexpr (!std::is_trivially_destructible_v<T>)
 			{
-				std::destroy_n(other_it, std::distance(other_it, other.end() - 1));
+				std::destroy_n(begin() + new_size, _size - new_size);
 			}
 		}
 
-		std::swap(_size, other._size);
+		_size = static_cast<size_field_type>(new_size);
+		note_growth();
+	}
+
+#if STATIC_VECTOR_HAS_EXECUTION
+	// Bulk operations under a standard execution policy, for vectors too large to fill, copy or destroy on one thread in good time.
+	// Each has the effect of its sequential overload, and runs that instead when it touches less than STATIC_VECTOR_PARALLEL_MIN_BYTES
+	// of elements. As with the standard parallel algorithms, an element operation throwing under the policy calls std::terminate.
+	// The size is only raised once the new elements are all constructed and lowered before the old ones are destroyed, so should the
+	// algorithm itself fail (std::bad_alloc for its temporary memory), the vector never counts an element that isn't alive.
+	template <typename Execution_Policy> requires (std::is_execution_policy_v<std::remove_cvref_t<Execution_Policy>>)
+	void assign(Execution_Policy&& execution, std::size_t count, const T& value)
+	{
+		if (!parallel_worthwhile(std::max<std::size_t>(std::min(count, Capacity), _size)))
+		{
+			assign(count, value);
+			return;
+		}
+
+		count = fit(count, Capacity, "Static vector lacks the capacity for so many elements!");
+		const std::size_t live = std::min<std::size_t>(_size, count);
+
+		std::fill_n(execution, data(), live, value);
+		if (count > live)
+		{
+			std::uninitialized_fill_n(execution, data() + live, count - live, value);
+			_size = static_cast<size_field_type>(count);
+			note_growth();
+		}
+		else
+		{
+			truncate(execution, count);
+		}
+	}
+
+	template <typename Execution_Policy, typename Iterator>
+		requires (std::is_execution_policy_v<std::remove_cvref_t<Execution_Policy>> && std::forward_iterator<Iterator> && std::is_convertible_v<typename std::iterator_traits<Iterator>::value_type, T>)
+	void assign(Execution_Policy&& execution, Iterator first, Iterator last)
+	{
+		const std::size_t count = static_cast<std::size_t>(std::distance(first, last));
+		if (!parallel_worthwhile(std::max<std::size_t>(std::min(count, Capacity), _size)))
+		{
+			assign(first, last);
+			return;
+		}
+
+		const std::size_t new_size = fit(count, Capacity, "Static vector lacks the capacity for so many elements!");
+		const std::size_t live = std::min<std::size_t>(_size, new_size);
+
+		std::copy_n(execution, first, live, data());
+		if (new_size > live)
+		{
+			std::uninitialized_copy_n(execution, std::next(first, static_cast<std::ptrdiff_t>(live)), new_size - live, data() + live);
+			_size = static_cast<size_field_type>(new_size);
+			note_growth();
+		}
+		else
+		{
+			truncate(execution, new_size);
+		}
+	}
+
+	// Replaces the contents with transform(element) for each element of [first, last), e.g. to rebuild a table from its source data.
+	template <typename Execution_Policy, typename Iterator, typename Transform>
+		requires (std::is_execution_policy_v<std::remove_cvref_t<Execution_Policy>> && std::random_access_iterator<Iterator>
+			&& std::is_convertible_v<std::invoke_result_t<Transform&, std::iter_reference_t<Iterator>>, T>)
+	void assign_transformed(Execution_Policy&& execution, Iterator first, Iterator last, Transform transform)
+	{
+		const std::size_t new_size = fit(static_cast<std::size_t>(last - first), Capacity, "Static vector lacks the capacity for so many elements!");
+		const std::size_t live = std::min<std::size_t>(_size, new_size);
+		T* const elements = data();
+
+		if (!parallel_worthwhile(std::max<std::size_t>(new_size, _size)))
+		{
+			std::transform(first, first + static_cast<std::ptrdiff_t>(live), elements, transform);
+			for (std::size_t i = live; i < new_size; ++i)
+			{
+				std::construct_at(elements + i, transform(first[static_cast<std::ptrdiff_t>(i)]));
+				_size = static_cast<size_field_type>(i + 1);
+			}
+		}
+		else
+		{
+			std::transform(execution, first, first + static_cast<std::ptrdiff_t>(live), elements, transform);
+			// There's no uninitialized transform, the slots themselves are iterated over to construct into them.
+			std::for_each(execution, elements + live, elements + new_size, [&](T& slot)
+			{
+				const std::ptrdiff_t index = &slot - elements;
+				std::construct_at(std::addressof(slot), transform(first[index]));
+			});
+			_size = std::max(_size, static_cast<size_field_type>(new_size));
+		}
+
+		note_growth();
+		truncate(execution, new_size);
+	}
+
+	template <typename Execution_Policy> requires (std::is_execution_policy_v<std::remove_cvref_t<Execution_Policy>> && std::is_default_constructible_v<T>)
+	void resize(Execution_Policy&& execution, std::size_t new_size)
+	{
+		if (!parallel_worthwhile(std::max<std::size_t>(std::min(new_size, Capacity), _size)))
+		{
+			resize(new_size);
+			return;
+		}
+
+		new_size = fit(new_size, Capacity, "Can't resize beyond capacity!");
+		if (new_size > _size)
+		{
+			std::uninitialized_value_construct_n(execution, data() + _size, new_size - _size);
+			_size = static_cast<size_field_type>(new_size);
+			note_growth();
+		}
+		else
+		{
+			truncate(execution, new_size);
+		}
+	}
+
+	template <typename Execution_Policy> requires (std::is_execution_policy_v<std::remove_cvref_t<Execution_Policy>>)
+	void clear(Execution_Policy&& execution)
+	{
+		truncate(execution, 0);
+	}
+#endif
+
+	consteval std::size_t max_size() const noexcept
+	{
+		return Capacity;
+	}
+
+	consteval std::size_t capacity() const noexcept
+	{
+		return Capacity;
+	}
+
+	// What data() is aligned to, alignof(T) unless the policy asks for more.
+	static consteval std::size_t data_alignment() noexcept
+	{
+		return buffer_alignment;
+	}
+
+	constexpr bool empty() const noexcept
+	{
+		return _size == 0;
+	}
+
+	constexpr std::size_t free_space() const noexcept
+	{
+		return Capacity - _size;
+	}
+
+	constexpr reference front() noexcept
+	{
+		return _storage.elements[0];
+	}
+
+	constexpr const_reference front() const noexcept
+	{
+		return _storage.elements[0];
+	}
+
+	constexpr reference back() noexcept
+	{
+		return _storage.elements[_size - 1];
+	}
+
+	constexpr const_reference back() const noexcept
+	{
+		return _storage.elements[_size - 1];
+	}
+
+	// Both data() overloads tell the compiler how the buffer is aligned, for loops over it to use aligned vector instructions.
+	constexpr pointer data() noexcept
+	{
+		return std::assume_aligned<buffer_alignment>(_storage.elements);
+	}
+
+	constexpr const_pointer data() const noexcept
+	{
+		return std::assume_aligned<buffer_alignment>(_storage.elements);
+	}
+
+	// Returned by index_of when the value isn't in the vector.
+	static constexpr std::size_t npos = static_vector_detail::not_found;
+
+	// Linear searches. For arithmetic and enum types they compare a full SIMD register of elements at a time, reading whole blocks of the
+	// (always allocated) buffer rather than stopping at size(). Floating point elements compare like operator==, so NaN is never found.
+	constexpr iterator find(const T& value) noexcept (static_vector_detail::is_nothrow_equality_comparable_v<T>) requires (std::equality_comparable<T>)
+	{
+		const std::size_t index = static_vector_detail::find_index(data(), _size, Capacity, value);
+		return index == npos ? end() : begin() + index;
+	}
+
+	constexpr const_iterator find(const T& value) const noexcept (static_vector_detail::is_nothrow_equality_comparable_v<T>) requires (std::equality_comparable<T>)
+	{
+		const std::size_t index = static_vector_detail::find_index(data(), _size, Capacity, value);
+		return index == npos ? cend() : cbegin() + index;
+	}
+
+	constexpr bool contains(const T& value) const noexcept (static_vector_detail::is_nothrow_equality_comparable_v<T>) requires (std::equality_comparable<T>)
+	{
+		return static_vector_detail::find_index(data(), _size, Capacity, value) != npos;
+	}
+
+	constexpr std::size_t count(const T& value) const noexcept (static_vector_detail::is_nothrow_equality_comparable_v<T>) requires (std::equality_comparable<T>)
+	{
+		return static_vector_detail::count_equal(data(), _size, Capacity, value);
+	}
+
+	// The index of the first element equal to value, or npos.
+	constexpr std::size_t index_of(const T& value) const noexcept (static_vector_detail::is_nothrow_equality_comparable_v<T>) requires (std::equality_comparable<T>)
+	{
+		return static_vector_detail::find_index(data(), _size, Capacity, value);
+	}
+
+	// Zero-copy serialization of trivially copyable elements, in the format described at static_vector_wire_header.
+	// The number of bytes serialize_into writes.
+	constexpr std::size_t serialized_size() const noexcept requires (std::is_trivially_copyable_v<T>)
+	{
+		return static_vector_detail::wire_data_offset<T> + _size * sizeof(T);
+	}
+
+	// Writes the header and then all the elements with a single memcpy to the front of buffer, which needs no particular alignment.
+	// Returns the number of bytes written, or 0 without writing anything if buffer is smaller than serialized_size().
+	std::size_t serialize_into(std::span<std::byte> buffer) const noexcept requires (std::is_trivially_copyable_v<T>)
+	{
+		const std::size_t bytes = serialized_size();
+		if (buffer.size() < bytes) [[unlikely]]
+		{
+			return 0;
+		}
+
+		static_vector_detail::write_wire_header<T>(buffer.data(), _size);
+		if (_size != 0)
+		{
+			std::memcpy(buffer.data() + static_vector_detail::wire_data_offset<T>, data(), _size * sizeof(T));
+		}
+
+		return bytes;
+	}
+
+	// Replaces the contents with the elements serialized at the front of buffer, copied with a single memcpy. buffer needs no
+	// particular alignment and may continue past the serialized vector. A malformed buffer isn't a programming error, so more
+	// elements than Capacity are rejected as too_many_elements rather than reported to the policy. On any error the vector is left as it was.
+	static_vector_wire_status deserialize_from(std::span<const std::byte> buffer) noexcept requires (std::is_trivially_copyable_v<T>)
+	{
+		std::size_t count = 0;
+		const static_vector_wire_status status = static_vector_detail::read_wire_header<T>(buffer, count);
+		if (status != static_vector_wire_status::ok) [[unlikely]]
+		{
+			return status;
+		}
+		if (count > Capacity) [[unlikely]]
+		{
+			return static_vector_wire_status::too_many_elements;
+		}
+
+		// Trivially copyable elements are trivially destructible, the old ones can just be overwritten.
+		if (count != 0)
+		{
+			std::memcpy(static_cast<void*>(data()), buffer.data() + static_vector_detail::wire_data_offset<T>, count * sizeof(T));
+		}
+		_size = static_cast<size_field_type>(count);
+		note_growth();
+
+		return static_vector_wire_status::ok;
+	}
+
+	// Placement in memory shared between processes (shm_open, memfd_create, a mapped file...) for trivially copyable elements.
+	// The region starts with a static_vector_region_header describing the layout and holds the vector right after it, region_bytes()
+	// in all. One process creates the vector with create_at, the others attach to it and use it in place, without a copy.
+	//
+	// While others read, the single writing process only appends with publish_emplace_back and publish_append, which store the
+	// new size with release ordering once the elements are written, and readers go through published_size() and published(),
+	// which load it with acquire ordering. A reader so always sees a prefix of completely written elements. Any other modification
+	// isn't synchronized with the readers.
+	static consteval std::size_t region_bytes() noexcept requires (std::is_trivially_copyable_v<T>)
+	{
+		return region_offset() + sizeof(static_vector);
+	}
+
+	// Constructs an empty vector in memory, which must be at least region_bytes() long and aligned for static_vector (pages are).
+	// Returns nullptr if it isn't, with the reason in status if one is given.
+	static static_vector* create_at(void* memory, std::size_t bytes, static_vector_wire_status* status = nullptr) noexcept requires (std::is_trivially_copyable_v<T>)
+	{
+		if (const static_vector_wire_status result = check_region(memory, bytes); result != static_vector_wire_status::ok) [[unlikely]]
+		{
+			return report(result, status);
+		}
+
+		auto* const header = ::new (memory) static_vector_region_header{
+			0,
+			static_vector_wire_version,
+			static_vector_detail::wire_native_byte_order,
+			static_cast<std::uint16_t>(alignof(T)),
+			static_cast<std::uint32_t>(sizeof(T)),
+			0,
+			static_cast<std::uint64_t>(Capacity),
+			static_cast<std::uint64_t>(sizeof(static_vector)) };
+
+		static_vector* const vector = ::new (static_cast<std::byte*>(memory) + region_offset()) static_vector();
+
+		std::atomic_ref<std::uint32_t>(header->magic).store(static_vector_region_magic, std::memory_order_release);
+
+		report(static_vector_wire_status::ok, status);
+		return vector;
+	}
+
+	// The vector another process created in memory with create_at, or nullptr if the region holds none or one of another layout,
+	// with the reason in status if one is given.
+	static static_vector* attach(void* memory, std::size_t bytes, static_vector_wire_status* status = nullptr) noexcept requires (std::is_trivially_copyable_v<T>)
+	{
+		if (const static_vector_wire_status result = check_region(memory, bytes); result != static_vector_wire_status::ok) [[unlikely]]
+		{
+			return report(result, status);
+		}
+
+		auto* const header = std::launder(static_cast<static_vector_region_header*>(memory));
+
+		if (std::atomic_ref<std::uint32_t>(header->magic).load(std::memory_order_acquire) != static_vector_region_magic)
+		{
+			return report(static_vector_wire_status::bad_magic, status);
+		}
+		if (header->version != static_vector_wire_version)
+		{
+			return report(static_vector_wire_status::unsupported_version, status);
+		}
+		if (header->byte_order != static_vector_detail::wire_native_byte_order)
+		{
+			return report(static_vector_wire_status::byte_order_mismatch, status);
+		}
+		if (header->element_alignment != alignof(T) || header->element_size != sizeof(T) ||
+			header->capacity != Capacity || header->object_size != sizeof(static_vector))
+		{
+			return report(static_vector_wire_status::layout_mismatch, status);
+		}
+
+		report(static_vector_wire_status::ok, status);
+		return std::launder(reinterpret_cast<static_vector*>(static_cast<std::byte*>(memory) + region_offset()));
 	}
 
-	constexpr reference operator[] (std::size_t index) noexcept(!STATIC_VECTOR_DEBUGGING)
+	// Appends an element and then publishes the new size, see region_bytes(). Returns the element, or nullptr if the policy
+	// let a full vector go on.
+	template <typename ... Args>
+	T* publish_emplace_back(Args&& ... args) noexcept (Policy::is_nothrow && std::is_nothrow_constructible_v<T, Args...>) requires (std::is_trivially_copyable_v<T>)
 	{
-		if constexpr (STATIC_VECTOR_DEBUGGING)
+		if (_size == Capacity) [[unlikely]]
 		{
-			if (index > _size - 1)
-			{
-				throw std::out_of_range("Index out of bounds!");
-			}
+			capacity_exceeded("Vector is at full capacity, push back not allowed!");
+			return nullptr;
 		}
 
-		return (*reinterpret_cast<T*>(&_data[index]));
+		T* const element = std::construct_at(data() + _size, std::forward<Args>(args)...);
+		shared_size().store(static_cast<size_field_type>(_size + 1), std::memory_order_release);
+		note_growth();
+
+		return element;
 	}
 
-	constexpr const_reference operator[] (std::size_t index) const noexcept(!STATIC_VECTOR_DEBUGGING)
+	// Appends values with a single memcpy and then publishes the new size, so readers see either none or all of them.
+	void publish_append(std::span<const T> values) noexcept (Policy::is_nothrow) requires (std::is_trivially_copyable_v<T>)
 	{
-		if constexpr (STATIC_VECTOR_DEBUGGING)
+		const std::size_t count = fit(values.size(), Capacity - _size, "Static vector lacks the capacity for so many elements!");
+		if (count == 0)
 		{
-			if (index > _size - 1)
-			{
-				throw std::out_of_range("Index out of bounds!");
-			}
+			return;
 		}
 
-		return (*reinterpret_cast<const T*>(&_data[index]));
+		std::memcpy(static_cast<void*>(data() + _size), values.data(), count * sizeof(T));
+		shared_size().store(static_cast<size_field_type>(_size + count), std::memory_order_release);
+		note_growth();
 	}
 
-	constexpr reference at(std::size_t index) 
+	// The size as last published by the writer. Every element below it is completely written.
+	std::size_t published_size() const noexcept requires (std::is_trivially_copyable_v<T>)
 	{
-		if (index > _size - 1)
-		{
-			throw std::out_of_range("Index out of bounds!");
-		}
+		return const_cast<static_vector*>(this)->shared_size().load(std::memory_order_acquire);
+	}
 
-		return (*reinterpret_cast<T*>(&_data[index]));
+	std::span<const T> published() const noexcept requires (std::is_trivially_copyable_v<T>)
+	{
+		return std::span<const T>(data(), published_size());
 	}
 
-	constexpr const_reference at(std::size_t index) const 
+private:
+
+	static consteval std::size_t region_offset() noexcept
+	{
+		return static_vector_detail::round_up(sizeof(static_vector_region_header), alignof(static_vector));
+	}
+
+	static static_vector_wire_status check_region(void* memory, std::size_t bytes) noexcept
 	{
-		if (index > _size - 1)
+		if (bytes < region_bytes())
 		{
-			throw std::out_of_range("Index out of bounds!");
+			return static_vector_wire_status::buffer_too_small;
 		}
-
-		return (*reinterpret_cast<const T*>(&_data[index]));
+		if (reinterpret_cast<std::uintptr_t>(memory) % alignof(static_vector) != 0)
+		{
+			return static_vector_wire_status::misaligned;
+		}
+		return static_vector_wire_status::ok;
 	}
 
-	constexpr void push_back(const T& val)
+	static static_vector* report(static_vector_wire_status result, static_vector_wire_status* status) noexcept
 	{
-		if (_size == Capacity)
+		if (status != nullptr)
 		{
-			throw std::runtime_error("Vector is at full capacity, push back not allowed!");
+			*status = result;
 		}
+		return nullptr;
+	}
 
-		std::construct_at(std::to_address(end()), val);
-		_size++;
+	// The size seen by other processes. Lock free atomics don't depend on the address they are accessed at, so they work across mappings.
+	std::atomic_ref<size_field_type> shared_size() noexcept
+	{
+		static_assert(std::atomic_ref<size_field_type>::is_always_lock_free, "the size of a shared static_vector has to be lock free");
+		static_assert(alignof(size_field_type) >= std::atomic_ref<size_field_type>::required_alignment);
+		return std::atomic_ref<size_field_type>(_size);
 	}
 
-	constexpr void push_back(T&& val)
+	// Reports an overflow to the instrumentation and then to the policy.
+	static constexpr void capacity_exceeded(const char* message) noexcept (Policy::is_nothrow)
 	{
-		if (_size == Capacity)
-		{
-			throw std::runtime_error("Vector is at full capacity, push back not allowed!");
-		}
+		instrumentation_type::overflowed();
+		Policy::capacity_exceeded(message);
+	}
 
-		std::construct_at(std::to_address(end()), std::forward<T>(val));
-		_size++;
+	constexpr void note_growth() noexcept
+	{
+		instrumentation_type::grown(_size);
 	}
 
-	constexpr void pop_back() 
+	// Checks that count elements fit in room, reporting an overflow to the policy. Returns how many elements the operation should go on with,
+	// which is only less than count if the policy let it continue.
+	static constexpr std::size_t fit(std::size_t count, std::size_t room, const char* message) noexcept(Policy::is_nothrow)
 	{
-		if (empty())
+		if (count > room) [[unlikely]]
 		{
-			throw std::runtime_error("Can't pop from empty vector!");
+			capacity_exceeded(message);
+			return room;
 		}
 
-		if constexpr (!std::is_trivially_destructible_v<T>)
+		return count;
+	}
+
+	// Constructors copying only the live elements leave the buffer past them uninitialized, which is all the elements need and saves
+	// zeroing a buffer that can be far larger than what it holds. A constant can't hold uninitialized elements though, so there
+	// trivial elements past from are zeroed like element_storage's default constructor would have.
+	constexpr void zero_constant_tail(std::size_t from) noexcept
+	{
+		if constexpr (static_vector_detail::zeroes_elements<T>)
 		{
-			std::destroy_at(reinterpret_cast<T*>(&_data[_size - 1]));
+			if (std::is_constant_evaluated())
+			{
+				static_vector_detail::uninitialized_value_construct_n(data() + from, Capacity - from);
+			}
 		}
+	}
 
-		_size--;
+#if STATIC_VECTOR_HAS_EXECUTION
+	// Whether an operation touching count elements is worth handing to an execution policy, see STATIC_VECTOR_PARALLEL_MIN_BYTES.
+	static constexpr bool parallel_worthwhile(std::size_t count) noexcept
+	{
+		return count * sizeof(T) >= STATIC_VECTOR_PARALLEL_MIN_BYTES;
 	}
 
-	template <typename ... Args>
-	constexpr void emplace_back(Args&& ... args)
+	// Does what element_storage's default constructor would have, for the buffer past from.
+	template <typename Execution_Policy>
+	void zero_tail(Execution_Policy& execution, std::size_t from)
 	{
-		if (_size == Capacity)
+		if constexpr (static_vector_detail::zeroes_elements<T>)
 		{
-			throw std::runtime_error("Vector is at full capacity, push back not allowed!");
+			if (parallel_worthwhile(Capacity - from))
+			{
+				std::uninitialized_value_construct_n(execution, data() + from, Capacity - from);
+			}
+			else
+			{
+				std::uninitialized_value_construct_n(data() + from, Capacity - from);
+			}
 		}
-
-		std::construct_at(std::to_address(end()), std::forward<Args>(args)...);
-		_size++;
 	}
 
-	constexpr void clear() noexcept (std::is_nothrow_destructible_v<T>)
+	// Destroys the elements past new_size, under the policy when there are enough of them.
+	template <typename Execution_Policy>
+	void truncate(Execution_Policy& execution, std::size_t new_size)
 	{
-		if constexpr (std::is_trivially_destructible_v<T>)
+		const std::size_t old_size = _size;
+		if (new_size >= old_size)
 		{
-			_size = 0;
+			return;
 		}
-		else
+
+		_size = static_cast<size_field_type>(new_size);
+		if constexpr (!std::is_trivially_destructible_v<T>)
 		{
-			if constexpr (std::is_nothrow_destructible_v<T>)
+			if (parallel_worthwhile(old_size - new_size))
 			{
-				std::destroy_n(begin(), size());
-				_size = 0;
+				std::destroy_n(execution, data() + new_size, old_size - new_size);
 			}
 			else
 			{
-				while (!empty())
-				{
-					pop_back();
-				}
+				std::destroy_n(data() + new_size, old_size - new_size);
 			}
 		}
 	}
+#endif
 
-	constexpr iterator insert(iterator pos, const T& value)
-	{
-		if (_size == Capacity)
-		{
-			throw std::runtime_error("Vector is at full capacity, insertion not allowed!");
-		}
-		
-		std::construct_at(std::to_address(end()), std::move(*(end() - 1)));
+	static constexpr bool nothrow_swappable = is_trivially_relocatable_v<T> ||
+		(std::is_nothrow_swappable_v<T> && (std::is_move_constructible_v<T> ? std::is_nothrow_move_constructible_v<T> : std::is_nothrow_copy_constructible_v<T>));
 
-		std::move_backward(pos, end() - 1, end());
+	// Exchanges the live elements of two buffers, each with room for the other's elements. Only the common prefix is swapped,
+	// the rest of the longer one is relocated in a single pass. Trivially relocatable elements are swapped as raw bytes.
+	static constexpr void swap_elements(T* left, std::size_t left_size, T* right, std::size_t right_size) noexcept (nothrow_swappable)
+	{
+		const std::size_t common = std::min(left_size, right_size);
 
-		*pos = value;
+		T* const longer = left_size > right_size ? left : right;
+		T* const shorter = left_size > right_size ? right : left;
+		const std::size_t tail = std::max(left_size, right_size) - common;
 
-		_size++;
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			if (std::is_constant_evaluated())
+			{
+				std::swap_ranges(left, left + common, right);
+			}
+			else
+			{
+				static_vector_detail::swap_bytes(left, right, common * sizeof(T));
+			}
+			static_vector_detail::relocate_n(longer + common, tail, shorter + common);
+		}
+		else
+		{
+			std::swap_ranges(left, left + common, right);
 
-		return pos;
+			if constexpr (std::is_move_constructible_v<T>)
+			{
+				static_vector_detail::uninitialized_move_n(longer + common, tail, shorter + common);
+			}
+			else
+			{
+				static_vector_detail::uninitialized_copy_n(longer + common, tail, shorter + common);
+			}
+			if constexpr (!std::is_trivially_destructible_v<T>)
+			{
+				std::destroy_n(longer + common, tail);
+			}
+		}
 	}
 
-	constexpr iterator insert(const_iterator pos, const T& value)
+	constexpr iterator to_mutable(const_iterator pos) noexcept
 	{
-		auto mutable_pos = *reinterpret_cast<iterator*>(&pos);
-		return this->insert(mutable_pos, value);
+		return begin() + static_cast<std::size_t>(pos - cbegin());
 	}
 
-	constexpr iterator erase(const_iterator pos) noexcept(std::is_nothrow_move_assignable_v<T>&& std::is_nothrow_destructible_v<T>)
+	// Opens a gap of count slots at index for an insertion to fill, and closes it again if the insertion throws before setting filled.
+	// Trivially relocatable elements are relocated back, which leaves the vector as it was. The element-wise shift of other types
+	// can't be undone, so the elements it moved past the end are destroyed instead: the size is left as it was and the elements from
+	// index on are valid but unspecified, e.g. moved-from.
+	struct gap_guard
 	{
-		for (iterator it = *reinterpret_cast<iterator*>(std::addressof(pos)); it != (end() - 1); ++it)
+		static_vector& self;
+		std::size_t index;
+		std::size_t count;
+		// How many elements open() move constructed past the end, they sit at the back of [end(), end() + count).
+		std::size_t moved_past_end = 0;
+		bool filled = false;
+
+		// Shifts the elements in [index, size()) count positions towards the back in a single pass, opening a gap at [index, index + count).
+		// The first slots of the gap still hold moved-from elements that must be assigned to, the rest is raw storage that must be constructed into.
+		// Returns the number of such moved-from slots. The size isn't updated, the caller does that once the gap is filled.
+		// Trivially relocatable elements are shifted with a single memmove, which leaves the whole gap raw.
+		constexpr std::size_t open()
 		{
-			*it = std::move(*(it + 1));
-		}
-		std::destroy_at(std::to_address(end() - 1));
+			const std::size_t tail = self._size - index;
+			const iterator position = self.begin() + index;
 
-		_size--;
+			instrumentation_type::shifted(tail);
 
-		return *reinterpret_cast<iterator*>(std::addressof(pos));
-	}
+			if constexpr (is_trivially_relocatable_v<T>)
+			{
+				static_vector_detail::relocate_n(std::to_address(position), tail, std::to_address(position) + count);
+				return 0;
+			}
 
-	constexpr iterator erase(const_iterator from, const_iterator to) noexcept(std::is_nothrow_move_assignable_v<T>&& std::is_nothrow_destructible_v<T>)
-	{
-		iterator it_1 = *reinterpret_cast<iterator*>(std::addressof(from));
-		auto to_2 = to + 1;
-		iterator it_2 = *reinterpret_cast<iterator*>(std::addressof(to_2));
+			if (count <= tail)
+			{
+				static_vector_detail::uninitialized_move(self.end() - count, self.end(), self.end());
+				moved_past_end = count;
+				std::move_backward(position, self.end() - count, self.end());
+				return count;
+			}
 
-		while (it_2 != end())
-		{
-			*it_1 = std::move(*it_2);
-			++it_1;
-			++it_2;
+			static_vector_detail::uninitialized_move(position, self.end(), position + count);
+			moved_past_end = tail;
+			return tail;
 		}
 
-		if (it_1 < to)
+		constexpr ~gap_guard()
 		{
-			std::destroy(it_1, *reinterpret_cast<iterator*>(std::addressof(to_2)));
-		}
-
-		_size = std::distance(begin(), it_1);
+			if (filled)
+			{
+				return;
+			}
 
-		return *reinterpret_cast<iterator*>(std::addressof(from));
-	}
+			if constexpr (is_trivially_relocatable_v<T>)
+			{
+				static_vector_detail::relocate_n(self.data() + index + count, self._size - index, self.data() + index);
+			}
+			else
+			{
+				std::destroy_n(self.data() + self._size + count - moved_past_end, moved_past_end);
+			}
+		}
+	};
 
-	// If T is trivially_destructible, static_vector<T> should be too.
-	// To get trivial destructibility, a class needs to default ~static_vector
-	// Use a requires clause to select the right version (default vs destroy_n)
-	//
-	// Citation--https://en.cppreference.com/w/cpp/language/destructor#Trivial_destructor
-	// See also
-	// - https://www.sandordargo.com/blog/2021/06/16/multiple-destructors-with-cpp-concepts
-	// - Sy Brand's talk "How to write well-behaved value wrappers",
-	//    https://youtu.be/sQcPte0JNmE?t=1147
-	//
-	// Unfortunately, this won't work on clang yet
-	constexpr ~static_vector() noexcept requires (std::is_trivially_destructible_v<T>) = default;
-	constexpr ~static_vector() noexcept (std::is_nothrow_destructible_v<T>)
-		requires(!std::is_trivially_destructible_v<T>)
+	constexpr iterator erase_n(std::size_t index, std::size_t count)
 	{
-		std::destroy_n(begin(), _size);
-	}
+		const iterator position = begin() + index;
 
-	constexpr std::size_t size() const noexcept
-	{
-		return _size;
-	}
+		// Closing an empty gap would move every element of the tail onto itself, which leaves them moved-from.
+		if (count == 0)
+		{
+			return position;
+		}
 
-	constexpr void resize(std::size_t new_size) noexcept (std::is_nothrow_default_constructible_v<T> && std::is_nothrow_destructible_v<T>)
-	{
-		if (new_size > Capacity)
-			throw std::runtime_error("Can't resize beyond capacity!");
+		instrumentation_type::shifted(_size - index - count);
 
-		if (new_size > _size)
+		if constexpr (is_trivially_relocatable_v<T>)
 		{
-			const auto difference = new_size - _size;
-			std::uninitialized_value_construct_n(begin() + difference, difference);
+			std::destroy_n(position, count);
+			static_vector_detail::relocate_n(std::to_address(position) + count, _size - index - count, std::to_address(position));
 		}
 		else
 		{
-			const auto difference = _size - new_size;
-
-			if constexpr (!std::is_trivially_destructible_v<T>)
-			{
-				std::destroy_n(begin() + difference, difference);
-			}
+			const iterator new_end = std::move(position + count, end(), position);
+			std::destroy(new_end, end());
 		}
 
-		_size = new_size;
-	}
+		_size -= static_cast<size_field_type>(count);
 
-	consteval std::size_t max_size() const noexcept
-	{
-		return Capacity;
+		return position;
 	}
 
-	consteval std::size_t capacity() const noexcept
+	// Removes the elements satisfying predicate, moving the survivors down over them in a single pass. The survivors behind the first
+	// removed element are the ones that move, they're reported as shifted like the tail that erase() moves to close its gap.
+	template <typename Predicate>
+	constexpr std::size_t compact(Predicate& predicate)
 	{
-		return Capacity;
-	}
+		T* const end = data() + _size;
+		T* const first = std::find_if(data(), end, std::ref(predicate));
+		if (first == end)
+		{
+			return 0;
+		}
 
-	constexpr bool empty() const noexcept
-	{
-		return _size == 0;
-	}
+		T* const new_end = std::remove_if(first, end, std::ref(predicate));
+		instrumentation_type::shifted(static_cast<std::size_t>(new_end - first));
+		truncate(static_cast<std::size_t>(new_end - data()));
 
-	constexpr std::size_t free_space() const noexcept
-	{
-		return Capacity - _size;
+		return static_cast<std::size_t>(end - new_end);
 	}
 
-	constexpr reference front() noexcept
+	template <typename Iterator>
+	constexpr iterator insert_counted(std::size_t index, Iterator first, std::size_t count)
 	{
-		return *reinterpret_cast<T*>(&_data[0]);
-	}
+		count = fit(count, Capacity - _size, "Static vector lacks the capacity for so many elements!");
 
-	constexpr const_reference front() const noexcept
-	{
-		return *reinterpret_cast<const T*>(&_data[0]);
-	}
+		// An empty gap would have the guard move every element of the tail onto itself, which leaves them moved-from.
+		if (count == 0)
+		{
+			return begin() + index;
+		}
 
-	constexpr reference back() noexcept
-	{
-		return *reinterpret_cast<T*>(&_data[_size - 1]);
-	}
+		gap_guard guard{ *this, index, count };
+		const std::size_t live = guard.open();
+		const iterator position = begin() + index;
 
-	constexpr const_reference back() const noexcept
-	{
-		return *reinterpret_cast<const T*>(&_data[_size - 1]);
+		const auto rest = std::ranges::copy_n(first, static_cast<std::ptrdiff_t>(live), position).in;
+		static_vector_detail::uninitialized_copy_n(rest, count - live, position + live);
+		guard.filled = true;
+
+		_size += static_cast<size_field_type>(count);
+		note_growth();
+
+		return position;
 	}
 
-	constexpr pointer data() noexcept
+	// Single pass ranges can't be measured up front, so they're appended and then rotated into place.
+	template <typename Iterator, typename Sentinel>
+	constexpr iterator insert_single_pass(std::size_t index, Iterator first, Sentinel last)
 	{
-		return reinterpret_cast<T*>(&_data[0]);
+		const std::size_t old_size = _size;
+		append_guard guard{ *this, old_size };
+
+		for (; first != last; ++first)
+		{
+			emplace_back(*first);
+		}
+
+		instrumentation_type::shifted(old_size - index);
+		std::rotate(begin() + index, begin() + old_size, end());
+		guard.done = true;
+
+		return begin() + index;
 	}
 
-	constexpr const_pointer data() const noexcept
+	// Destroys the elements appended past old_size if the insertion throws before setting done. Thrown while appending, that leaves
+	// the vector as it was. Thrown by a move while rotating, the size is as it was and the elements are valid but unspecified.
+	struct append_guard
 	{
-		return reinterpret_cast<const T*>(&_data[0]);
-	}
+		static_vector& self;
+		std::size_t old_size;
+		bool done = false;
+
+		constexpr ~append_guard()
+		{
+			if (!done)
+			{
+				std::destroy(self.begin() + old_size, self.end());
+				self._size = static_cast<size_field_type>(old_size);
+			}
+		}
+	};
 };
 
-template <typename T, std::size_t lc, std::size_t rc> requires (std::equality_comparable<T>)
-constexpr bool operator==(const static_vector<T, lc>& lhs, const static_vector<T, rc> rhs) noexcept
+template <typename T, std::size_t lc, typename lp, std::size_t rc, typename rp> requires (std::equality_comparable<T>)
+constexpr bool operator==(const static_vector<T, lc, lp>& lhs, const static_vector<T, rc, rp>& rhs) noexcept
 {
 	return std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
 }
 
-template <typename T, std::size_t lc, std::size_t rc> requires (std::equality_comparable<T>)
-constexpr auto operator<=>(const static_vector<T, lc>& lhs, const static_vector<T, rc> rhs) noexcept
+template <typename T, std::size_t lc, typename lp, std::size_t rc, typename rp> requires (std::equality_comparable<T>)
+constexpr auto operator<=>(const static_vector<T, lc, lp>& lhs, const static_vector<T, rc, rp>& rhs) noexcept
 {
 	return std::lexicographical_compare_three_way(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
 }
 
-template <typename T, std::size_t LCapacity, std::size_t RCapacity> requires (LCapacity != RCapacity && std::is_swappable_v<T> && (std::is_copy_constructible_v<T> || std::is_move_constructible_v<T>))
-constexpr void swap(static_vector<T, LCapacity>& lhs, static_vector<T, RCapacity>& rhs) noexcept (std::is_nothrow_swappable_v<T> && ((!std::is_move_constructible_v<T>&& std::is_nothrow_copy_constructible_v<T>) || std::is_nothrow_move_constructible_v<T>))
+template <typename T, std::size_t LCapacity, std::size_t RCapacity, typename Policy> requires (LCapacity != RCapacity && std::is_swappable_v<T> && (std::is_copy_constructible_v<T> || std::is_move_constructible_v<T>))
+constexpr void swap(static_vector<T, LCapacity, Policy>& lhs, static_vector<T, RCapacity, Policy>& rhs) noexcept (noexcept(lhs.swap(rhs)))
 {
 	lhs.swap(rhs);
 }
 
-template <typename T, std::size_t Capacity> requires (std::is_swappable_v<T> && (std::is_copy_constructible_v<T> || std::is_move_constructible_v<T>))
-constexpr void swap(static_vector<T, Capacity>& lhs, static_vector<T, Capacity>& rhs) noexcept (std::is_nothrow_swappable_v<T> && (std::is_move_constructible_v<T> || std::is_copy_constructible_v<T>) && std::is_nothrow_destructible_v<T>)
+template <typename T, std::size_t Capacity, typename Policy> requires (std::is_swappable_v<T> && (std::is_copy_constructible_v<T> || std::is_move_constructible_v<T>))
+constexpr void swap(static_vector<T, Capacity, Policy>& lhs, static_vector<T, Capacity, Policy>& rhs) noexcept (noexcept(lhs.swap(rhs)))
 {
-	if (&lhs == &rhs)
-	{
-		return;
-	}
+	lhs.swap(rhs);
+}
 
-	auto left_it = lhs.begin();
-	auto right_it = rhs.begin();
+template <typename T, std::size_t Capacity, typename Policy> requires (std::equality_comparable<T>)
+constexpr auto find(static_vector<T, Capacity, Policy>& vector, const std::type_identity_t<T>& value) noexcept (noexcept(vector.find(value)))
+{
+	return vector.find(value);
+}
 
-	for (; left_it != lhs.end() && right_it != rhs.end(); ++left_it, ++right_it)
-	{
-		std::swap(*left_it, *right_it);
-	}
+template <typename T, std::size_t Capacity, typename Policy> requires (std::equality_comparable<T>)
+constexpr auto find(const static_vector<T, Capacity, Policy>& vector, const std::type_identity_t<T>& value) noexcept (noexcept(vector.find(value)))
+{
+	return vector.find(value);
+}
 
-	if (left_it != lhs.end())
-	{
-		if constexpr (std::is_move_constructible_v<T>)
-		{
-			std::uninitialized_move(left_it, lhs.end(), rhs.end());
-		}
-		else
-		{
-			std::uninitialized_copy(left_it, lhs.end(), rhs.end());
-		}
-		if constexpr (!std::is_trivially_destructible_v<T>)
-		{
-			std::destroy_n(left_it, std::distance(left_it, lhs.end() - 1));
-		}
-	}
-	if (right_it != rhs.end())
-	{
-		if constexpr (std::is_move_constructible_v<T>)
-		{
-			std::uninitialized_move(right_it, rhs.end(), lhs.end());
-		}
-		else
-		{
-			std::uninitialized_copy(right_it, rhs.end(), lhs.end());
-		}
-		if constexpr (!std::is_trivially_destructible_v<T>)
-		{
-			std::destroy_n(right_it, std::distance(right_it, rhs.end() - 1));
-		}
-	}
+template <typename T, std::size_t Capacity, typename Policy> requires (std::equality_comparable<T>)
+constexpr bool contains(const static_vector<T, Capacity, Policy>& vector, const std::type_identity_t<T>& value) noexcept (noexcept(vector.contains(value)))
+{
+	return vector.contains(value);
+}
+
+template <typename T, std::size_t Capacity, typename Policy> requires (std::equality_comparable<T>)
+constexpr std::size_t count(const static_vector<T, Capacity, Policy>& vector, const std::type_identity_t<T>& value) noexcept (noexcept(vector.count(value)))
+{
+	return vector.count(value);
+}
+
+template <typename T, std::size_t Capacity, typename Policy> requires (std::equality_comparable<T>)
+constexpr std::size_t index_of(const static_vector<T, Capacity, Policy>& vector, const std::type_identity_t<T>& value) noexcept (noexcept(vector.index_of(value)))
+{
+	return vector.index_of(value);
+}
+
+// Removes every element satisfying predicate, compacting the survivors in a single pass. Returns how many elements were removed.
+template <typename T, std::size_t Capacity, typename Policy, typename Predicate> requires (std::predicate<Predicate&, T&>)
+constexpr std::size_t erase_if(static_vector<T, Capacity, Policy>& vector, Predicate predicate)
+{
+	return vector.compact(predicate);
+}
 
-	std::swap(lhs._size, rhs._size);
+// Removes every element equal to value, compacting the survivors in a single pass. Returns how many elements were removed.
+template <typename T, std::size_t Capacity, typename Policy, typename U> requires (std::equality_comparable_with<T, U>)
+constexpr std::size_t erase(static_vector<T, Capacity, Policy>& vector, const U& value)
+{
+	return erase_if(vector, [&value](const T& element) { return element == value; });
 }
 
 namespace static_vector_static_assertions
@@ -1505,4 +3357,129 @@ namespace static_vector_static_assertions
 	static_assert(std::is_nothrow_swappable_v<static_vector<int, 10>>);
 	static_assert(!std::is_nothrow_swappable_v<static_vector<NO_THROW_MOVE<false>, 10>>);
 	//static_assert(std::is_nothrow_swappable_v<static_vector<NO_THROW_COPYABLE<true>, 10>>);  // fix this one later
+
+	// The size field only takes as many bytes as Capacity requires.
+	static_assert(sizeof(static_vector<std::uint8_t, 15>) == 16);
+	static_assert(sizeof(static_vector<std::uint8_t, 255>) == 256);
+	static_assert(sizeof(static_vector<std::uint16_t, 1000>) == 2002);
+	static_assert(sizeof(static_vector<std::uint32_t, 3>) == 16);
+	static_assert(sizeof(byte_budget_static_vector<std::uint8_t, 64>) == 64);
+	static_assert(byte_budget_static_vector<std::uint8_t, 64>{}.capacity() == 63);
+	static_assert(sizeof(cache_line_static_vector<std::uint32_t>) == 64);
+	static_assert(cache_line_static_vector<std::uint32_t>{}.capacity() == 15);
+	static_assert(sizeof(byte_budget_static_vector<double, 4096>) <= 4096);
+
+	// Over-aligning the buffer only adds padding, the size field still goes after the last element.
+	static_assert(alignof(aligned_static_vector<float, 256, 32>) == 32 && sizeof(aligned_static_vector<float, 256, 32>) == 1024 + 32);
+	static_assert(sizeof(aligned_static_vector<float, 250, 32>) == 1024);
+	static_assert(aligned_static_vector<float, 256>::data_alignment() == 64 && static_vector<float, 256>::data_alignment() == alignof(float));
+	static_assert(std::is_trivially_copyable_v<aligned_static_vector<float, 32>>);
+	static_assert(sizeof(aligned_static_vector<std::uint64_t, 6, alignof(std::uint64_t), true>) == 64 && sizeof(static_vector<std::uint64_t, 6>) == 56);
+	static_assert(sizeof(byte_budget_static_vector<float, 128, static_vector_alignment<32>>) == 128);
+	static_assert(byte_budget_static_vector<float, 128, static_vector_alignment<32>>{}.capacity() == 31);
+
+	// A shared region is the 32 byte header followed by the vector at its alignment.
+	static_assert(static_vector<int, 100>::region_bytes() == 32 + sizeof(static_vector<int, 100>));
+	static_assert(static_vector<double, 3>::region_bytes() == 32 + 32);
+
+	// Trivially copyable types and opted in types are relocated with memmove, which makes moving them nothrow regardless of T's move constructor.
+	static_assert(is_trivially_relocatable_v<int>);
+	static_assert(is_trivially_relocatable_v<std::unique_ptr<int>>);
+	static_assert(!is_trivially_relocatable_v<std::string>);
+	static_assert(std::is_nothrow_move_constructible_v<static_vector<std::unique_ptr<int>, 10>>);
+	static_assert(std::is_nothrow_swappable_v<static_vector<std::unique_ptr<int>, 10>>);
+
+	// Small buffers of trivially copyable elements are copied whole, large ones only copy their live elements unless told otherwise.
+	static_assert(std::is_trivially_copyable_v<static_vector<int, 64>>);
+	static_assert(!std::is_trivially_copyable_v<static_vector<int, 128>>);
+	static_assert(std::is_trivially_copyable_v<static_vector<int, 4096, static_vector_copy_mode<false>>>);
+	static_assert(!std::is_trivially_copyable_v<static_vector<int, 4, static_vector_copy_mode<true>>>);
+	static_assert(std::is_nothrow_copy_constructible_v<static_vector<int, 4096>> && std::is_nothrow_move_assignable_v<static_vector<int, 4096>>);
+
+	// Copying only the live elements still leaves a constant with a fully initialized buffer.
+	constexpr static_vector<int, 4, static_vector_copy_mode<true>> live_prefix_source{ 1, 2 };
+	constexpr static_vector<int, 4, static_vector_copy_mode<true>> live_prefix_copy = live_prefix_source;
+	constexpr static_vector<int, 4, static_vector_copy_mode<true>> live_prefix_move = static_vector<int, 4, static_vector_copy_mode<true>>{ 3 };
+	static_assert(live_prefix_copy == live_prefix_source && live_prefix_move.size() == 1 && live_prefix_move[0] == 3);
+
+	// The non throwing append API is only as noexcept as constructing T.
+	static_assert(noexcept(std::declval<static_vector<int, 10>&>().try_push_back(1)));
+	static_assert(noexcept(std::declval<static_vector<int, 10>&>().unchecked_emplace_back(1)));
+	static_assert(!noexcept(std::declval<static_vector<std::string, 10>&>().try_emplace_back("")));
+
+	// With a non throwing error policy, operations that could only fail on capacity become noexcept.
+	static_assert(std::is_nothrow_constructible_v<static_vector<int, 10, static_vector_terminate_policy>, const static_vector<int, 20, static_vector_terminate_policy>&>);
+	static_assert(std::is_nothrow_swappable_with_v<static_vector<int, 10, static_vector_saturate_policy>&, static_vector<int, 20, static_vector_saturate_policy>&>);
+	static_assert(noexcept(std::declval<static_vector<int, 10, static_vector_terminate_policy>&>().resize(5)));
+
+	// Tables can be built at compile time and kept as constants.
+	constexpr static_vector<int, 16> build_table()
+	{
+		static_vector<int, 16> table;
+		for (int i = 0; i < 8; ++i)
+		{
+			table.push_back(8 - i);
+		}
+		table.insert(table.begin() + 2, { 20, 10 });
+		table.erase(table.begin());
+		table.emplace(table.begin() + 4, 0);
+		std::sort(table.begin(), table.end());
+		table.pop_back();
+		return table;
+	}
+
+	constexpr static_vector<int, 16> table = build_table();
+	static_assert(table.size() == 9 && table.front() == 0 && table.back() == 10 && *table.rbegin() == 10);
+	static_assert(std::is_sorted(table.begin(), table.end()) && table.contains(7) && !table.contains(8));
+
+	// Elements with constructors and destructors of their own work during constant evaluation too.
+	constexpr std::size_t total_length()
+	{
+		static_vector<std::string, 4> words{ "constant", "evaluation" };
+		words.insert(words.begin() + 1, "time");
+		words.erase(words.begin());
+		static_vector<std::string, 4> copy = words;
+		copy.swap(words);
+		std::size_t length = 0;
+		for (const std::string& word : copy)
+		{
+			length += word.size();
+		}
+		return length;
+	}
+
+	static_assert(total_length() == 14);
+
+	// Inserting nothing, e.g. an empty range or into a full vector whose policy drops what doesn't fit, leaves the elements alone.
+	constexpr bool inserts_nothing()
+	{
+		const static_vector<std::string, 4> none;
+		static_vector<std::string, 4> words{ "alpha", "beta", "gamma" };
+		words.insert(words.begin() + 1, none.begin(), none.end());
+		words.insert(words.begin(), std::initializer_list<std::string>{});
+
+		static_vector<std::string, 3, static_vector_saturate_policy> full{ "alpha", "beta", "gamma" };
+		full.insert(full.begin(), { std::string("delta") });
+
+		return words == static_vector<std::string, 4>{ "alpha", "beta", "gamma" } && full == words;
+	}
+
+	static_assert(inserts_nothing());
+
+	// Erasing an empty range, anywhere, leaves the elements alone.
+	constexpr bool erases_nothing()
+	{
+		static_vector<std::string, 4> words{ "alpha", "beta", "gamma" };
+		words.erase(words.begin() + 1, words.begin() + 1);
+		words.erase(words.end(), words.end());
+
+		return words == static_vector<std::string, 4>{ "alpha", "beta", "gamma" };
+	}
+
+	static_assert(erases_nothing());
+
+#if STATIC_VECTOR_HAS_EXCEPTIONS
+	static_assert(!std::is_nothrow_constructible_v<static_vector<int, 10, static_vector_throw_policy>, const static_vector<int, 20, static_vector_throw_policy>&>);
+	static_assert(!noexcept(std::declval<static_vector<int, 10, static_vector_throw_policy>&>().resize(5)));
+#endif
 }
\ No newline at end of file
@@ -0,0 +1,303 @@
+#pragma once
+
+#include "static_vector.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <typeinfo>
+
+#if __has_include(<cxxabi.h>)
+#include <cxxabi.h>
+#endif
+
+// Opt-in instrumentation, for picking capacities from real traffic rather than by guesswork. A static_vector whose policy is
+// static_vector_instrumented<"tag"> (wrapping another policy, the default one unless told otherwise) tracks the largest size it has
+// had, and each combination of element type, capacity and tag, a site, counts over the whole process:
+//  - how many vectors were constructed, and the largest size any of them reached,
+//  - overflow attempts, whether the policy then threw or dropped the elements, or a try_ operation returned nullptr,
+//  - elements shifted by insertions and erasures in the middle of a vector,
+//  - whole vector copies and moves, between vectors of the same type. A move that has to copy the elements counts as a copy.
+// static_vector_report() writes the sites out as text or JSON, on demand, or at exit with static_vector_report_at_exit().
+//
+// The counters are relaxed atomics, so instrumented vectors can live on any thread. Each one holds a size_t more and is no longer
+// trivially copyable. Vectors with other policies are unaffected: their hooks are empty and their layout is unchanged.
+// The report names element types through typeid, so it needs RTTI.
+
+// A string usable as a template argument, naming a site in the report.
+template <std::size_t N>
+struct static_vector_tag
+{
+	char name[N];
+
+	constexpr static_vector_tag(const char (&text)[N]) noexcept
+	{
+		std::copy_n(text, N, name);
+	}
+};
+
+// The counters of one site.
+struct static_vector_site
+{
+	const std::type_info* element_type;
+	std::size_t element_size;
+	std::size_t capacity;
+	const char* tag;
+
+	std::atomic<std::uint64_t> constructions{ 0 };
+	std::atomic<std::size_t> peak{ 0 };
+	std::atomic<std::uint64_t> overflows{ 0 };
+	std::atomic<std::uint64_t> shifted_elements{ 0 };
+	std::atomic<std::uint64_t> copies{ 0 };
+	std::atomic<std::uint64_t> moves{ 0 };
+
+	static_vector_site* next = nullptr;
+};
+
+namespace static_vector_instrumentation_detail
+{
+	// Every site of the process, in an intrusive list they prepend themselves to during static initialization.
+	inline std::atomic<static_vector_site*> sites{ nullptr };
+
+	inline bool register_site(static_vector_site& site) noexcept
+	{
+		site.next = sites.load(std::memory_order_relaxed);
+		while (!sites.compare_exchange_weak(site.next, &site, std::memory_order_release, std::memory_order_relaxed))
+		{
+		}
+		return true;
+	}
+
+	inline void raise(std::atomic<std::size_t>& peak, std::size_t size) noexcept
+	{
+		std::size_t current = peak.load(std::memory_order_relaxed);
+		while (size > current && !peak.compare_exchange_weak(current, size, std::memory_order_relaxed))
+		{
+		}
+	}
+}
+
+template <static_vector_tag Tag = "", typename Policy = static_vector_default_policy>
+struct static_vector_instrumented : Policy
+{
+	// What static_vector<T, Capacity, static_vector_instrumented> derives from, see static_vector_detail::no_instrumentation.
+	template <typename T, std::size_t Capacity>
+	class instrumentation
+	{
+	public:
+
+		constexpr instrumentation() noexcept
+		{
+			if (!std::is_constant_evaluated())
+			{
+				static_cast<void>(registered);
+				site.constructions.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		// A copy is a new vector with a peak of its own, static_vector reports the copy itself.
+		constexpr instrumentation(const instrumentation&) noexcept
+			: instrumentation()
+		{
+		}
+
+		constexpr instrumentation& operator=(const instrumentation&) noexcept
+		{
+			return *this;
+		}
+
+		constexpr std::size_t peak() const noexcept
+		{
+			return _peak;
+		}
+
+		constexpr void grown(std::size_t size) noexcept
+		{
+			if (size > _peak)
+			{
+				_peak = size;
+				if (!std::is_constant_evaluated())
+				{
+					static_vector_instrumentation_detail::raise(site.peak, size);
+				}
+			}
+		}
+
+		static constexpr void overflowed() noexcept
+		{
+			add(site.overflows, 1);
+		}
+
+		static constexpr void shifted(std::size_t count) noexcept
+		{
+			add(site.shifted_elements, count);
+		}
+
+		static constexpr void copied() noexcept
+		{
+			add(site.copies, 1);
+		}
+
+		static constexpr void moved() noexcept
+		{
+			add(site.moves, 1);
+		}
+
+	private:
+
+		static constexpr void add(std::atomic<std::uint64_t>& counter, std::uint64_t amount) noexcept
+		{
+			if (!std::is_constant_evaluated())
+			{
+				counter.fetch_add(amount, std::memory_order_relaxed);
+			}
+		}
+
+		// Constant initialized, so it is usable before its registration and trivially destroyed, still there for a report at exit.
+		inline static static_vector_site site{ &typeid(T), sizeof(T), Capacity, Tag.name };
+		inline static const bool registered = static_vector_instrumentation_detail::register_site(site);
+
+		std::size_t _peak = 0;
+	};
+};
+
+enum class static_vector_report_format
+{
+	text,
+	json
+};
+
+namespace static_vector_instrumentation_detail
+{
+	inline std::string type_name(const std::type_info& type)
+	{
+#if __has_include(<cxxabi.h>)
+		int status = 0;
+		const std::unique_ptr<char, decltype(&std::free)> demangled(abi::__cxa_demangle(type.name(), nullptr, nullptr, &status), &std::free);
+		if (status == 0 && demangled)
+		{
+			return demangled.get();
+		}
+#endif
+		return type.name();
+	}
+
+	inline void write_json_string(std::FILE* out, const std::string& text)
+	{
+		std::fputc('"', out);
+		for (const char c : text)
+		{
+			if (c == '"' || c == '\\')
+			{
+				std::fprintf(out, "\\%c", c);
+			}
+			else if (static_cast<unsigned char>(c) < 0x20)
+			{
+				std::fprintf(out, "\\u%04x", static_cast<unsigned>(c));
+			}
+			else
+			{
+				std::fputc(c, out);
+			}
+		}
+		std::fputc('"', out);
+	}
+
+	// Bytes of capacity no vector of the site ever used.
+	inline std::size_t unused_bytes(const static_vector_site& site) noexcept
+	{
+		return (site.capacity - site.peak.load(std::memory_order_relaxed)) * site.element_size;
+	}
+
+	inline static_vector_report_format exit_report_format = static_vector_report_format::text;
+}
+
+// Writes out every site: first those that overflowed, most overflows first, as their capacity is too small, then the others by the bytes
+// of capacity none of their vectors ever used, most first, as the candidates for a smaller one. A site is known as soon as a constructor
+// of its vector type is compiled in, so those whose vectors were never constructed are listed too, with zero counts.
+inline void static_vector_report(std::FILE* out = stderr, static_vector_report_format format = static_vector_report_format::text)
+{
+	using namespace static_vector_instrumentation_detail;
+
+	std::vector<const static_vector_site*> report;
+	for (const static_vector_site* site = sites.load(std::memory_order_acquire); site != nullptr; site = site->next)
+	{
+		report.push_back(site);
+	}
+
+	std::sort(report.begin(), report.end(), [](const static_vector_site* a, const static_vector_site* b)
+	{
+		const std::uint64_t a_overflows = a->overflows.load(std::memory_order_relaxed);
+		const std::uint64_t b_overflows = b->overflows.load(std::memory_order_relaxed);
+		if (a_overflows != b_overflows)
+		{
+			return a_overflows > b_overflows;
+		}
+		return unused_bytes(*a) > unused_bytes(*b);
+	});
+
+	if (format == static_vector_report_format::json)
+	{
+		std::fputs("[", out);
+	}
+	else
+	{
+		std::fprintf(out, "%-24s %10s %10s %6s %12s %10s %12s %10s %10s  %s\n",
+			"tag", "capacity", "peak", "fill%", "constructed", "overflows", "shifted", "copies", "moves", "element type");
+	}
+
+	for (std::size_t i = 0; i < report.size(); ++i)
+	{
+		const static_vector_site& site = *report[i];
+		const std::size_t peak = site.peak.load(std::memory_order_relaxed);
+		const unsigned long long constructions = site.constructions.load(std::memory_order_relaxed);
+		const unsigned long long overflows = site.overflows.load(std::memory_order_relaxed);
+		const unsigned long long shifted = site.shifted_elements.load(std::memory_order_relaxed);
+		const unsigned long long copies = site.copies.load(std::memory_order_relaxed);
+		const unsigned long long moves = site.moves.load(std::memory_order_relaxed);
+		const std::string element_type = type_name(*site.element_type);
+
+		if (format == static_vector_report_format::json)
+		{
+			std::fputs(i == 0 ? "\n  {\"tag\": " : ",\n  {\"tag\": ", out);
+			write_json_string(out, site.tag);
+			std::fputs(", \"element_type\": ", out);
+			write_json_string(out, element_type);
+			std::fprintf(out, ", \"element_size\": %zu, \"capacity\": %zu, \"peak\": %zu, \"constructions\": %llu, \"overflows\": %llu, "
+				"\"shifted_elements\": %llu, \"copies\": %llu, \"moves\": %llu}",
+				site.element_size, site.capacity, peak, constructions, overflows, shifted, copies, moves);
+		}
+		else
+		{
+			std::fprintf(out, "%-24s %10zu %10zu %6.1f %12llu %10llu %12llu %10llu %10llu  %s\n",
+				site.tag, site.capacity, peak, 100.0 * static_cast<double>(peak) / static_cast<double>(site.capacity),
+				constructions, overflows, shifted, copies, moves, element_type.c_str());
+		}
+	}
+
+	if (format == static_vector_report_format::json)
+	{
+		std::fputs(report.empty() ? "]\n" : "\n]\n", out);
+	}
+
+	std::fflush(out);
+}
+
+// Writes the report to stderr when the program exits normally. Call it once, e.g. at the start of main.
+inline void static_vector_report_at_exit(static_vector_report_format format = static_vector_report_format::text)
+{
+	static_vector_instrumentation_detail::exit_report_format = format;
+	std::atexit([] { static_vector_report(stderr, static_vector_instrumentation_detail::exit_report_format); });
+}
+
+namespace static_vector_instrumentation_static_assertions
+{
+	// Instrumentation only costs the vectors that ask for it.
+	static_assert(std::is_trivially_copyable_v<static_vector<int, 10>>);
+	static_assert(sizeof(static_vector<std::uint8_t, 15>) == 16);
+	static_assert(!std::is_trivially_copyable_v<static_vector<int, 10, static_vector_instrumented<"assertions">>>);
+	static_assert(sizeof(static_vector<int, 10, static_vector_instrumented<"assertions">>) == static_vector_detail::round_up(sizeof(std::size_t) + sizeof(static_vector<int, 10>), alignof(std::size_t)));
+
+	// It wraps the error policy without changing it.
+	static_assert(noexcept(std::declval<static_vector<int, 10, static_vector_instrumented<"assertions", static_vector_terminate_policy>>&>().resize(5)));
+	static_assert(std::is_nothrow_copy_constructible_v<static_vector<int, 10, static_vector_instrumented<"assertions">>>);
+}
@@ -0,0 +1,190 @@
+#pragma once
+
+#include "static_vector.hpp"
+
+// A read-only view of a static_vector serialized with serialize_into, validated and used in place without copying the elements,
+// e.g. straight out of a network buffer, a memory mapped file or shared memory.
+//
+// Construction checks the header (see static_vector_wire_header) and that the elements it announces fit in the buffer. A buffer
+// that doesn't pass gives an empty view whose status() tells why. The elements are only viewed in place if the buffer is aligned
+// for T, at least to alignof(T); otherwise the view is misaligned, and the vector can still be copied out with deserialize_from.
+//
+// The view points into the buffer, which has to outlive it and stay unchanged. Like std::span it is cheap to copy.
+template <typename T, typename Policy = static_vector_default_policy>
+class static_vector_view
+{
+	static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable elements are serialized as raw bytes");
+
+public:
+
+	using value_type = T;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = const T&;
+	using const_reference = const T&;
+	using pointer = const T*;
+	using const_pointer = const T*;
+	using iterator = const T*;
+	using const_iterator = const T*;
+	using reverse_iterator = std::reverse_iterator<const T*>;
+	using const_reverse_iterator = std::reverse_iterator<const T*>;
+
+	// An empty view that didn't come from any buffer.
+	constexpr static_vector_view() noexcept = default;
+
+	explicit static_vector_view(std::span<const std::byte> bytes) noexcept
+	{
+		std::size_t count = 0;
+		_status = static_vector_detail::read_wire_header<T>(bytes, count);
+		if (_status != static_vector_wire_status::ok)
+		{
+			return;
+		}
+
+		// The elements start at a multiple of alignof(T) from the header, so an aligned buffer is all it takes.
+		if (reinterpret_cast<std::uintptr_t>(bytes.data()) % alignof(T) != 0)
+		{
+			_status = static_vector_wire_status::misaligned;
+			return;
+		}
+
+		// The bytes were written from objects of trivially copyable T, which implicitly come back to life here.
+		_data = reinterpret_cast<const T*>(bytes.data() + static_vector_detail::wire_data_offset<T>);
+		_size = count;
+	}
+
+	constexpr static_vector_wire_status status() const noexcept
+	{
+		return _status;
+	}
+
+	constexpr explicit operator bool() const noexcept
+	{
+		return _status == static_vector_wire_status::ok;
+	}
+
+	// How many bytes of the buffer the serialized vector takes, to step to whatever follows it. 0 if the buffer wasn't valid.
+	constexpr std::size_t serialized_size() const noexcept
+	{
+		return _data == nullptr ? 0 : static_vector_detail::wire_data_offset<T> + _size * sizeof(T);
+	}
+
+	constexpr std::size_t size() const noexcept
+	{
+		return _size;
+	}
+
+	constexpr bool empty() const noexcept
+	{
+		return _size == 0;
+	}
+
+	constexpr const T* data() const noexcept
+	{
+		return _data;
+	}
+
+	constexpr std::span<const T> elements() const noexcept
+	{
+		return std::span<const T>(_data, _size);
+	}
+
+	constexpr operator std::span<const T>() const noexcept
+	{
+		return elements();
+	}
+
+	constexpr const_iterator begin() const noexcept
+	{
+		return _data;
+	}
+
+	constexpr const_iterator end() const noexcept
+	{
+		return _data + _size;
+	}
+
+	constexpr const_iterator cbegin() const noexcept
+	{
+		return begin();
+	}
+
+	constexpr const_iterator cend() const noexcept
+	{
+		return end();
+	}
+
+	constexpr const_reverse_iterator rbegin() const noexcept
+	{
+		return const_reverse_iterator(end());
+	}
+
+	constexpr const_reverse_iterator rend() const noexcept
+	{
+		return const_reverse_iterator(begin());
+	}
+
+	constexpr const T& operator[](std::size_t index) const noexcept
+	{
+		static_vector_detail::debug_check(index < _size, "index out of range in static_vector_view::operator[]");
+		return _data[index];
+	}
+
+	constexpr const T& at(std::size_t index) const noexcept (Policy::is_nothrow)
+	{
+		if (index >= _size) [[unlikely]]
+		{
+			Policy::out_of_range("Index out of range in static_vector_view::at!");
+		}
+		return _data[index];
+	}
+
+	constexpr const T& front() const noexcept
+	{
+		static_vector_detail::debug_check(_size != 0, "front() called on an empty static_vector_view");
+		return _data[0];
+	}
+
+	constexpr const T& back() const noexcept
+	{
+		static_vector_detail::debug_check(_size != 0, "back() called on an empty static_vector_view");
+		return _data[_size - 1];
+	}
+
+private:
+
+	const T* _data = nullptr;
+	std::size_t _size = 0;
+	static_vector_wire_status _status = static_vector_wire_status::ok;
+};
+
+// The elements live in the viewed buffer, not in the view.
+template <typename T, typename Policy>
+inline constexpr bool std::ranges::enable_borrowed_range<static_vector_view<T, Policy>> = true;
+
+template <typename T, typename Policy>
+inline constexpr bool std::ranges::enable_view<static_vector_view<T, Policy>> = true;
+
+namespace static_vector_view_static_assertions
+{
+	static_assert(std::ranges::contiguous_range<static_vector_view<int>>);
+	static_assert(std::ranges::borrowed_range<static_vector_view<int>>);
+	static_assert(std::ranges::view<static_vector_view<int>>);
+	static_assert(std::is_trivially_copyable_v<static_vector_view<int>>);
+
+	// Elements follow the 24 byte header, after padding for the more strictly aligned ones.
+	struct alignas(32) wide
+	{
+		std::byte bytes[32];
+	};
+
+	static_assert(static_vector_detail::wire_data_offset<int> == 24);
+	static_assert(static_vector_detail::wire_data_offset<wide> == 32);
+	static_assert(static_vector<int, 10>{}.serialized_size() == 24);
+
+	template <typename Vector>
+	concept serializable = requires (const Vector& vector, std::span<std::byte> buffer) { vector.serialize_into(buffer); };
+
+	static_assert(serializable<static_vector<int, 10>>);
+	static_assert(!serializable<static_vector<std::string, 10>>);
+}